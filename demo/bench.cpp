@@ -0,0 +1,425 @@
+// Micro-benchmarks of the schedulability tests and of the main graph algorithms.
+//
+// The fixtures are nested fork-join DAGs with an exact number of vertices, drawn from fixed
+// random streams, so every run of the same build analyses the same tasksets. Each function is
+// run once as warm-up and then repeatedly; every call gets an AnalysisBudget, and a function
+// whose warm-up exceeds it is reported as timed out without repetitions.
+//
+// usage: ./bench [output.json] [repetitions] [timeout (s)] [fixture/function filter]
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <cmath>
+
+#include "dagSched/Taskset.h"
+#include "dagSched/tests.h"
+#include "dagSched/SP-Tree.h"
+#include "dagSched/RandomStream.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/PerfCounters.h"
+#include "dagSched/AllocAccounting.h"
+
+using namespace dagSched;
+
+const uint64_t BENCH_SEED = 1;
+
+struct fixture{
+    std::string name;
+    int n_tasks     = 0;
+    int vertices    = 0;    // vertices per task
+    int m           = 0;
+    float U         = 0;    // target utilization of the taskset
+    Taskset taskset;
+    Taskset partitioned;    // same tasks on their own vertices, assigned to the cores with WorstFit
+};
+
+struct benchResult{
+    std::string fixture;
+    std::string function;
+    int verdict = 0;
+    std::vector<double> times;  // microseconds, one per repetition
+    perfStats counters;         // performance counters summed over the repetitions
+    allocStats alloc;           // allocations of the last repetition
+};
+
+// adds a fork-join block with exactly n vertices, returns its fork and join vertices.
+// As in the Melani generator, every branch is either a single vertex or a nested block, with at
+// most depth levels of nested blocks: this is the structure the NFJ conversion and the SP-tree
+// decomposition of Fonseca2017 handle, deeper nesting makes them fail.
+std::pair<int,int> addForkJoin(const int n, const int depth, RandomStream& rng, std::vector<int>& c, std::vector<std::pair<int,int>>& edges){
+    auto new_vertex = [&](){
+        c.push_back(rng.intRandMaxMin(1, 100));
+        return (int) c.size() - 1;
+    };
+
+    if(n == 1){
+        const int v = new_vertex();
+        return std::make_pair(v, v);
+    }
+
+    // fork and join are numbered before the branches, as in the Melani generator
+    const int fork = new_vertex();
+    const int join = new_vertex();
+    const int inner = n - 2;
+
+    // branches start as single vertices, some of them grow into nested blocks (at least 4 vertices)
+    std::vector<int> sizes(std::min(inner, rng.intRandMaxMin(2, 7)), 1);
+    int left = inner - sizes.size();
+    const int n_blocks = left >= 3 && depth > 0 ? rng.intRandMaxMin(1, std::min((int) sizes.size(), left / 3) + 1) : 0;
+    for(int b=0; b<n_blocks; ++b){
+        sizes[b] = 4;
+        left -= 3;
+    }
+    if(n_blocks == 0)
+        sizes.insert(sizes.end(), left, 1);
+    else
+        for(; left > 0; --left)
+            sizes[rng.intRandMaxMin(0, n_blocks)]++;
+
+    std::vector<std::pair<int,int>> branches;
+    for(const int size: sizes)
+        branches.push_back(addForkJoin(size, depth - 1, rng, c, edges));
+
+    for(const auto& b: branches){
+        edges.push_back(std::make_pair(fork, b.first));
+        edges.push_back(std::make_pair(b.second, join));
+    }
+    return std::make_pair(fork, join);
+}
+
+// task with n_vertices subtasks, implicit deadline and the given utilization (bounded by the length)
+DAGTask makeTask(const int n_vertices, const float u, const int n_types, RandomStream& rng){
+    std::vector<int> c;
+    std::vector<std::pair<int,int>> edges;
+    addForkJoin(n_vertices, 2, rng, c, edges);
+
+    YAML::Node tasks_node;
+    YAML::Node task_node;
+    task_node["t"] = 1;
+    task_node["d"] = 1;
+    for(int i=0; i<c.size(); ++i){
+        YAML::Node v;
+        v["id"] = i;
+        v["c"] = c[i];
+        v["s"] = rng.intRandMaxMin(0, n_types);
+        task_node["vertices"].push_back(v);
+    }
+    for(const auto& e: edges){
+        YAML::Node edge;
+        edge["from"] = e.first;
+        edge["to"] = e.second;
+        task_node["edges"].push_back(edge);
+    }
+    tasks_node.push_back(task_node);
+
+    DAGTask t;
+    t.readTaskFromYamlNode(tasks_node, 0);
+    t.transitiveReduction();
+    t.buildCSR();
+    const Time_t period = std::max(t.getLength(), toTime(std::ceil(t.getVolume() / u)));
+    t.assignFixedSchedParameters(period, period);
+    t.computeMetrics();
+    return t;
+}
+
+fixture makeFixture(const std::string& name, const int n_tasks, const int n_vertices, const int m, const float U){
+    fixture f;
+    f.name = name;
+    f.n_tasks = n_tasks;
+    f.vertices = n_vertices;
+    f.m = m;
+    f.U = U;
+
+    RandomStream rng(BENCH_SEED, n_vertices, n_tasks * 1000 + m);
+    for(int i=0; i<n_tasks; ++i)
+        f.taskset.tasks.push_back(makeTask(n_vertices, U / n_tasks, 2, rng));
+    f.taskset.computeUtilization();
+    f.taskset.computeHyperPeriod();
+    f.taskset.computeMaxDensity();
+
+    f.partitioned = f.taskset;
+    for(auto& t: f.partitioned.tasks){
+        std::vector<SubTask*> V = t.getVertices();
+        t.cloneVertices(V);
+    }
+    WorstFitProcessorsAssignment(f.partitioned, f.m);
+    for(auto& t: f.partitioned.tasks)
+        t.computeMetrics();
+    return f;
+}
+
+// run fn once as warm-up and then repetitions times; fn returns the verdict.
+// The performance counters of each repetition are read around fn only, when perf_event_open is
+// available to the process; allocations are counted when the library is built with accounting.
+benchResult measure(const fixture& f, const std::string& name, const int repetitions, const float timeout, const std::function<int()>& fn){
+    benchResult r;
+    r.fixture = f.name;
+    r.function = name;
+
+    PerfCounters& counters = PerfCounters::threadCounters();
+    auto run = [&](double& time, perfSample& sample){
+        AnalysisBudget budget(timeout);
+        BudgetScope scope(budget);
+        r.alloc = allocStats();
+        SimpleTimer timer;
+        timer.tic();
+        counters.start();
+        int verdict;
+        {
+            AllocScope alloc_scope(r.alloc);
+            verdict = fn();
+        }
+        sample = counters.stop();
+        time = timer.toc();
+        return budget.isExhausted() ? Verdict_t::TIMED_OUT : verdict;
+    };
+
+    double time = 0;
+    perfSample sample;
+    r.verdict = run(time, sample);
+    if(r.verdict == Verdict_t::TIMED_OUT)
+        return r;
+
+    for(int i=0; i<repetitions; ++i){
+        r.verdict = run(time, sample);
+        if(r.verdict == Verdict_t::TIMED_OUT){
+            r.times.clear();
+            r.counters = perfStats();
+            r.alloc = allocStats();
+            break;
+        }
+        r.times.push_back(time);
+        r.counters.calls++;
+        for(int e=0; e<N_PERF_EVENTS; ++e)
+            if(sample.valid[e]){
+                r.counters.sum[e] += sample.value[e];
+                r.counters.validCalls[e]++;
+            }
+    }
+    return r;
+}
+
+std::vector<benchResult> benchFixture(const fixture& f, const int repetitions, const float timeout, const std::string& filter){
+    std::vector<benchResult> results;
+    const Taskset& ts = f.taskset;
+    const Taskset& pts = f.partitioned;
+    const DAGTask& task = ts.tasks[0];
+    const int m = f.m;
+    const std::vector<int> typed_proc = {std::max(1, m / 2), std::max(1, m - m / 2)};
+
+    auto bench = [&](const std::string& name, const std::function<int()>& fn){
+        // the filter matches either the function or the "fixture/function" pair
+        if(!filter.empty() && (f.name + "/" + name).find(filter) == std::string::npos)
+            return;
+        results.push_back(measure(f, name, repetitions, timeout, fn));
+        const benchResult& r = results.back();
+        std::cerr<<f.name<<" "<<name<<" verdict: "<<r.verdict;
+        if(!r.times.empty()){
+            std::vector<double> sorted = r.times;
+            std::sort(sorted.begin(), sorted.end());
+            std::cerr<<" median: "<<sorted[sorted.size() / 2]<<" us";
+        }
+        std::cerr<<std::endl;
+    };
+
+    // graph algorithms, on copies of the first task with their own vertices
+    bench("transitiveReduction", [&]{
+        DAGTask t = task;
+        std::vector<SubTask*> V = t.getVertices();
+        t.cloneVertices(V);
+        t.transitiveReduction();
+        return 1;
+    });
+    bench("computeWorstCaseWorkload", [&]{
+        DAGTask t = task;
+        t.computeWorstCaseWorkload();
+        return 1;
+    });
+    bench("convertNFJDAGtoSPTree", [&]{
+        SPTree tree;
+        tree.convertNFJDAGtoSPTree(task, 0);
+        return 1;
+    });
+    bench("computeWorkloadDistributionCO", [&]{ return (int) !computeWorkloadDistributionCO(task, 0).empty(); });
+    bench("computeWorkloadDistributionCI", [&]{ return (int) !computeWorkloadDistributionCI(task).empty(); });
+    bench("workloadUpperBound", [&]{ return (int) (workloadUpperBound(task, task.getPeriod(), m) > 0); });
+
+    // partitioning, on copies with their own vertices
+    bench("WorstFitProcessorsAssignment", [&]{
+        Taskset t = ts;
+        for(auto& tau: t.tasks){
+            std::vector<SubTask*> V = tau.getVertices();
+            tau.cloneVertices(V);
+        }
+        return (int) WorstFitProcessorsAssignment(t, m);
+    });
+    bench("BestFitProcessorsAssignment", [&]{
+        Taskset t = ts;
+        for(auto& tau: t.tasks){
+            std::vector<SubTask*> V = tau.getVertices();
+            tau.cloneVertices(V);
+        }
+        return (int) BestFitProcessorsAssignment(t, m);
+    });
+
+    // single DAG tests, on the first task
+    bench("Graham1969", [&]{ return (int) Graham1969(task, m); });
+    bench("GP_FP_EDF_Baruah2012_C", [&]{ return (int) GP_FP_EDF_Baruah2012_C(task, m); });
+    bench("GP_FP_EDF_Baruah2012_A", [&]{ return (int) GP_FP_EDF_Baruah2012_A(task, m); });
+    bench("GP_FP_Han2019_C_1", [&]{ return (int) GP_FP_Han2019_C_1(task, typed_proc); });
+    bench("GP_FP_He2019_C", [&]{ return (int) GP_FP_He2019_C(task, m); });
+
+    // global tests
+    bench("GP_FP_EDF_Bonifaci2013_A", [&]{ return (int) GP_FP_EDF_Bonifaci2013_A(ts, m); });
+    bench("GP_FP_DM_Bonifaci2013_A", [&]{ return (int) GP_FP_DM_Bonifaci2013_A(ts, m); });
+    bench("GP_FP_DM_Bonifaci2013_C", [&]{ return (int) GP_FP_DM_Bonifaci2013_C(ts, m); });
+    bench("GP_FP_EDF_Li2013_I", [&]{ return (int) GP_FP_EDF_Li2013_I(ts, m); });
+    bench("GP_FP_EDF_Qamhieh2013_C", [&]{ return (int) GP_FP_EDF_Qamhieh2013_C(ts, m); });
+    bench("GP_FP_EDF_Baruah2014_C", [&]{ return (int) GP_FP_EDF_Baruah2014_C(ts, m); });
+    bench("GP_FP_EDF_Melani2015_C", [&]{ return (int) GP_FP_EDF_Melani2015_C(ts, m); });
+    bench("GP_FP_FTP_Melani2015_C", [&]{ return (int) GP_FP_FTP_Melani2015_C(ts, m); });
+    bench("GP_FP_DM_Pathan2017_C", [&]{ return (int) GP_FP_DM_Pathan2017_C(ts, m); });
+    // the workload distributions of the Fonseca tests are cached in the tasks and shared by their
+    // copies: every repetition gets a copy with an empty cache, so that building them is timed as
+    // in the versions without the cache; the _cached variants time the analyses on the filled cache
+    auto uncached = [&]{
+        Taskset t = ts;
+        for(auto& tau: t.tasks)
+            tau.resetArtifactCache();
+        return t;
+    };
+    bench("GP_FP_FTP_Fonseca2017_C", [&]{ return (int) GP_FP_FTP_Fonseca2017_C(uncached(), m); });
+    bench("GP_FP_FTP_Fonseca2019_C", [&]{ return (int) GP_FP_FTP_Fonseca2019(uncached(), m); });
+    bench("GP_FP_FTP_Fonseca2019_A", [&]{ return (int) GP_FP_FTP_Fonseca2019(uncached(), m, false); });
+    bench("GP_FP_FTP_Fonseca2017_C_cached", [&]{ return (int) GP_FP_FTP_Fonseca2017_C(ts, m); });
+    bench("GP_FP_FTP_Fonseca2019_C_cached", [&]{ return (int) GP_FP_FTP_Fonseca2019(ts, m); });
+    bench("GP_FP_FTP_Fonseca2019_A_cached", [&]{ return (int) GP_FP_FTP_Fonseca2019(ts, m, false); });
+    bench("GP_FP_FTP_He2019_C", [&]{ return (int) GP_FP_FTP_He2019_C(ts, m); });
+    bench("GP_LP_FTP_Serrano16_C", [&]{ return (int) GP_LP_FTP_Serrano16_C(ts, m); });
+    bench("G_LP_FTP_Nasri2019_C", [&]{ return (int) G_LP_FTP_Nasri2019_C(ts, m); });
+
+    // partitioned tests, on the WorstFit assignment
+    bench("P_FP_FTP_Fonseca2016_C", [&]{ return (int) P_FP_FTP_Fonseca2016_C(pts, m); });
+    bench("P_LP_FTP_Casini2018_C", [&]{ return (int) P_LP_FTP_Casini2018_C(pts, m); });
+    bench("P_LP_FTP_Casini2018_C_withAssignment", [&]{ return (int) P_LP_FTP_Casini2018_C_withAssignment(ts, m, PartitioningCoresOrder_t::WORST_FIT); });
+    #ifdef ZAHAF2019
+    bench("P_LP_EDF_Zahaf2019_C", [&]{ return (int) P_LP_EDF_Zahaf2019_C(pts, m); });
+    #endif
+
+    return results;
+}
+
+std::string jsonString(const std::string& s){
+    std::string out = "\"";
+    for(const char ch: s){
+        if(ch == '"' || ch == '\\')
+            out += '\\';
+        out += ch;
+    }
+    return out + "\"";
+}
+
+void writeJson(std::ostream& out, const std::vector<fixture>& fixtures, const std::vector<benchResult>& results, const int repetitions, const float timeout){
+    char num[64];
+    out<<"{\n";
+    out<<"  \"seed\": "<<BENCH_SEED<<",\n";
+    out<<"  \"repetitions\": "<<repetitions<<",\n";
+    out<<"  \"warmup\": 1,\n";
+    snprintf(num, sizeof(num), "%.9g", timeout);
+    out<<"  \"timeout_s\": "<<num<<",\n";
+    out<<"  \"perf_counters\": "<<(PerfCounters::threadCounters().available() ? "true" : "false")<<",\n";
+    out<<"  \"alloc_accounting\": "<<(allocAccountingEnabled() ? "true" : "false")<<",\n";
+    out<<"  \"time\": "<<jsonString(std::is_integral<Time_t>::value ? "integer" : "float")<<",\n";
+
+    out<<"  \"fixtures\": [\n";
+    for(int i=0; i<fixtures.size(); ++i){
+        const fixture& f = fixtures[i];
+        int edges = 0;
+        for(const auto& t: f.taskset.tasks)
+            for(const auto& v: t.getVertices())
+                edges += v->succ.size();
+        snprintf(num, sizeof(num), "%.9g", f.taskset.getUtilization());
+        out<<"    {\"name\": "<<jsonString(f.name)<<", \"n_tasks\": "<<f.n_tasks<<", \"vertices_per_task\": "<<f.vertices
+           <<", \"edges\": "<<edges<<", \"m\": "<<f.m<<", \"U\": "<<num<<"}"<<(i + 1 < fixtures.size() ? "," : "")<<"\n";
+    }
+    out<<"  ],\n";
+
+    out<<"  \"results\": [\n";
+    for(int i=0; i<results.size(); ++i){
+        const benchResult& r = results[i];
+        out<<"    {\"fixture\": "<<jsonString(r.fixture)<<", \"function\": "<<jsonString(r.function)
+           <<", \"verdict\": "<<r.verdict<<", \"timed_out\": "<<(r.verdict == Verdict_t::TIMED_OUT ? "true" : "false");
+        if(!r.times.empty()){
+            std::vector<double> sorted = r.times;
+            std::sort(sorted.begin(), sorted.end());
+            const double mean = std::accumulate(sorted.begin(), sorted.end(), 0.) / sorted.size();
+            double var = 0;
+            for(const double t: sorted)
+                var += (t - mean) * (t - mean);
+            const double stddev = std::sqrt(var / sorted.size());
+            snprintf(num, sizeof(num), "%.6g", sorted.front());
+            out<<", \"min_us\": "<<num;
+            snprintf(num, sizeof(num), "%.6g", sorted[sorted.size() / 2]);
+            out<<", \"median_us\": "<<num;
+            snprintf(num, sizeof(num), "%.6g", mean);
+            out<<", \"mean_us\": "<<num;
+            snprintf(num, sizeof(num), "%.6g", stddev);
+            out<<", \"stddev_us\": "<<num;
+            snprintf(num, sizeof(num), "%.6g", sorted.back());
+            out<<", \"max_us\": "<<num;
+        }
+        // mean of each available counter over the repetitions
+        for(int e=0; e<N_PERF_EVENTS; ++e)
+            if(r.counters.validCalls[e]){
+                snprintf(num, sizeof(num), "%.6g", (double) r.counters.sum[e] / r.counters.validCalls[e]);
+                out<<", \""<<perfEventName((PerfEvent_t) e)<<"\": "<<num;
+            }
+        if(allocAccountingEnabled() && !r.times.empty())
+            out<<", \"allocations\": "<<r.alloc.allocations<<", \"bytes\": "<<r.alloc.bytes<<", \"peak_bytes\": "<<r.alloc.peakBytes;
+        out<<"}"<<(i + 1 < results.size() ? "," : "")<<"\n";
+    }
+    out<<"  ]\n";
+    out<<"}\n";
+}
+
+int main(int argc, char **argv){
+    std::string output = "bench.json";
+    if(argc > 1)
+        output = argv[1];
+    int repetitions = 10;
+    if(argc > 2)
+        repetitions = atoi(argv[2]);
+    float timeout = 1;
+    if(argc > 3)
+        timeout = atof(argv[3]);
+    std::string filter;
+    if(argc > 4)
+        filter = argv[4];
+
+    // DAG size sweep (single task), number of tasks sweep and number of cores sweep
+    std::vector<fixture> fixtures;
+    for(const int v: {10, 100, 1000, 10000})
+        fixtures.push_back(makeFixture("V" + std::to_string(v) + "_n1_m8", 1, v, 8, 0.5 * 8));
+    for(const int n: {10, 100})
+        fixtures.push_back(makeFixture("V50_n" + std::to_string(n) + "_m8", n, 50, 8, 0.5 * 8));
+    for(const int m: {2, 64})
+        fixtures.push_back(makeFixture("V50_n10_m" + std::to_string(m), 10, 50, m, 0.5 * m));
+
+    std::vector<benchResult> results;
+    for(const auto& f: fixtures){
+        std::vector<benchResult> r = benchFixture(f, repetitions, timeout, filter);
+        results.insert(results.end(), r.begin(), r.end());
+    }
+
+    std::ofstream out(output);
+    if(!out.is_open())
+        FatalError("Can't write " + output);
+    writeJson(out, fixtures, results, repetitions, timeout);
+    out.close();
+    std::cout<<"results written to "<<output<<std::endl;
+    return 0;
+}
@@ -1,20 +1,26 @@
 #include "dagSched/evaluate.h"
 int main(int argc, char *argv[]) {
 
-    if(REPRODUCIBLE) srand (1);
-    else srand (time(NULL));
-
     std::string gp_file = "../data/n_task_DAG_EDF_C_varyingU.yml";
     if(argc > 1)
         gp_file = argv[1];
     bool show_plots = true;
     if(argc > 2)
         show_plots = atoi(argv[2]);
+    bool resume = false;
+    if(argc > 3)
+        resume = atoi(argv[3]);
 
     std::string o_file;
     removePathAndExtension(gp_file, o_file);
 
     system("mkdir -p res");
-    dagSched::evaluate(gp_file, "res/" + o_file, show_plots);
+
+    // results of a previous run: plot them again without running the analyses
+    const std::string csv_ext = ".csv";
+    if(gp_file.size() > csv_ext.size() && gp_file.compare(gp_file.size() - csv_ext.size(), csv_ext.size(), csv_ext) == 0)
+        dagSched::plotSavedResults(gp_file, "res/" + o_file, show_plots);
+    else
+        dagSched::evaluate(gp_file, "res/" + o_file, show_plots, resume);
     return 0;
 }
\ No newline at end of file
@@ -2,15 +2,13 @@
 #include "dagSched/DAGTask.h"
 #include "dagSched/Taskset.h"
 #include "dagSched/tests.h"
+#include "dagSched/Admission.h"
 #include "dagSched/plot_utils.h"
 
 #include <ctime>    
 
 int main(int argc, char **argv){
 
-    if(REPRODUCIBLE) srand (1);
-    else srand (time(NULL));
-
     bool random_creation = true;
     if(argc > 1)
         random_creation = atoi(argv[1]);
@@ -29,7 +27,8 @@ int main(int argc, char **argv){
         dagSched::GeneratorParams gp;
         gp.configureParams(dagSched::GenerationType_t::VARYING_N);
 
-        taskset.generate_taskset_Melani(n_tasks, U_tot, n_proc, gp);
+        dagSched::RandomStream rng(gp.seed);
+        taskset.generate_taskset_Melani(n_tasks, U_tot, n_proc, gp, rng);
     }
     else{
         size_t ext  = taskset_filename.find("yaml");
@@ -120,4 +119,15 @@ int main(int argc, char **argv){
 
     std::cout<< "\tFonseca 2019 arbitrary (GP-FP-FTP): "<<dagSched::GP_FP_FTP_Fonseca2019(taskset, n_proc, false)<<std::endl;
 
+    //cascade admission: cheap tests first, expensive ones only if needed
+    if(constrained_taskset){
+        dagSched::GeneratorParams admission_gp;
+        admission_gp.sType = dagSched::SchedulingType_t::GLOBAL;
+        admission_gp.aType = dagSched::AlgorithmType_t::FTP;
+        admission_gp.dtype = dagSched::DeadlinesType_t::CONSTRAINED;
+        dagSched::admissionResult adm = dagSched::cascadeAdmission(taskset, n_proc, admission_gp);
+        std::cout<<"Cascade admission (GP-FTP): "<<adm.admitted<<" decided by "<<(adm.decidedBy.empty() ? "none" : adm.decidedBy)
+                 <<" ("<<adm.decidingTime<<" us, "<<adm.steps.size()<<" steps, "<<adm.totalTime<<" us total)"<<std::endl;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <vector>
+#include <string>
+
+#include "dagSched/Taskset.h"
+#include "dagSched/GeneratorParams.h"
+#include "dagSched/AnalysisBudget.h"
+
+namespace dagSched{
+
+// 级联准入中的一步: 一个必要条件或一个分析
+struct admissionStep{
+    std::string test;       // 必要条件或分析的名称
+    int verdict     = 0;    // 判定结果(Verdict_t)
+    double time     = 0;    // 耗时(微秒)
+};
+
+// 级联准入的结果
+struct admissionResult{
+    bool admitted       = false;    // 是否可调度
+    std::string decidedBy;          // 作出判定的必要条件或分析, 没有分析接受时为空
+    double decidingTime = 0;        // 作出判定的一步的耗时(微秒)
+    double totalTime    = 0;        // 总耗时(微秒)
+    std::vector<admissionStep> steps;   // 按执行顺序的每一步
+};
+
+// 级联准入
+// 先检查必要条件(存在任务的最长链长度大于截止时间, 或总利用率大于处理器数量时不可调度),
+// 然后按代价等级从低到高依次运行注册表中支持gp所描述模型的分析(同一等级内按注册顺序),
+// 第一个判定为可调度的充分条件即决定结果; 所有分析都未接受时不可调度。
+// 分析的选择与预算与evaluate()相同(gp.analyses, gp.maxCost, gp.timeout, gp.maxIterations),
+// 超时的分析视为未接受。需要分区的分析在任务集的副本上以WorstFit分配子任务后运行。
+// gp.wType为SINGLE_DAG时任务集必须只包含一个任务, 否则报错。
+admissionResult cascadeAdmission(const Taskset& taskset, const int m, const GeneratorParams& gp);
+
+}
+
+#endif /* ADMISSION_H */
@@ -0,0 +1,41 @@
+#ifndef ALLOCACCOUNTING_H
+#define ALLOCACCOUNTING_H
+
+#include <cstdint>
+
+namespace dagSched{
+
+// 一段代码的内存分配统计
+struct allocStats{
+    uint64_t allocations    = 0;    // 分配次数
+    uint64_t bytes          = 0;    // 分配的总字节数
+    uint64_t peakBytes      = 0;    // 同时存活的最大字节数
+    int64_t liveBytes       = 0;    // 当前存活的字节数
+};
+
+// 编译时是否启用了分配统计(CMake选项WITH_ALLOC_ACCOUNTING)
+// 启用时库替换全局的operator new/delete, 每次分配多占用16字节用于记录大小和所属的统计;
+// 未启用时AllocScope不记录任何东西。
+bool allocAccountingEnabled();
+
+// 在作用域内统计当前线程通过operator new进行的分配, 析构时恢复之前的统计
+// 只有在作用域内分配的内存在释放时才从liveBytes中减去, 因此作用域之前分配的内存在作用域内释放
+// 不影响统计, 作用域结束后才释放的内存不计入峰值的减少。嵌套的作用域只记录在最内层。
+// 统计是线程局部的, 因此并发执行的分析各自独立统计。
+class AllocScope{
+
+    allocStats* previous;
+    uint64_t previousId;
+
+    public:
+
+    explicit AllocScope(allocStats& stats);
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+}
+
+#endif /* ALLOCACCOUNTING_H */
@@ -0,0 +1,65 @@
+#ifndef ANALYSISBUDGET_H
+#define ANALYSISBUDGET_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace dagSched{
+
+// 分析的判定结果
+// TIMED_OUT: 分析在预算内没有完成, 既不算可调度也不算不可调度
+enum Verdict_t {NOT_SCHEDULABLE = 0, SCHEDULABLE = 1, TIMED_OUT = 2};
+
+// 单个分析的执行预算: 墙钟时间上限和迭代次数上限, 为0时不限制
+// 分析中可能很长的循环(路径枚举、不动点迭代、SP树上的计算、NP状态空间搜索)每轮调用一次
+// budgetExhausted(), 预算耗尽后分析尽快返回, 返回值被忽略, 结果记为TIMED_OUT。
+class AnalysisBudget{
+
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point start;
+    double timeLimit        = 0;    // 墙钟时间上限(秒)
+    uint64_t maxIterations  = 0;    // 迭代次数上限
+    uint64_t iterations     = 0;    // 已进行的迭代次数
+    bool exhausted          = false;
+
+    public:
+
+    AnalysisBudget(const double time_limit = 0, const uint64_t max_iterations = 0);
+
+    // 记录一次迭代, 预算耗尽时返回true
+    bool step();
+
+    // 外部分析(如NP状态空间搜索)自行超时后标记预算耗尽
+    void exhaust() {exhausted = true;}
+    bool isExhausted() const {return exhausted;}
+
+    bool hasTimeLimit() const {return timeLimit > 0;}
+    // 剩余时间(秒), 至少为一个很小的正数, 以免被外部分析当作不限时
+    double remainingTime() const;
+};
+
+// 在当前线程上安装预算, 析构时恢复之前的预算
+// 预算是线程局部的, 因此并发执行的分析各自独立计时, 不需要修改分析的接口。
+class BudgetScope{
+
+    AnalysisBudget* previous;
+
+    public:
+
+    explicit BudgetScope(AnalysisBudget& budget);
+    ~BudgetScope();
+
+    BudgetScope(const BudgetScope&) = delete;
+    BudgetScope& operator=(const BudgetScope&) = delete;
+};
+
+// 当前线程上的预算, 没有时为nullptr
+AnalysisBudget* currentBudget();
+
+// 记录当前分析的一次迭代, 预算耗尽时返回true; 当前线程没有预算时总是返回false
+bool budgetExhausted();
+
+}
+
+#endif /* ANALYSISBUDGET_H */
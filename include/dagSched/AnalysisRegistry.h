@@ -0,0 +1,60 @@
+#ifndef ANALYSISREGISTRY_H
+#define ANALYSISREGISTRY_H
+
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "dagSched/Taskset.h"
+#include "dagSched/GeneratorParams.h"
+
+namespace dagSched{
+
+// 可调度性分析的入口, 返回任务集是否可调度
+typedef std::function<bool(const Taskset& taskset, const int m, const GeneratorParams& gp)> analysisFunc_t;
+
+// 一个可调度性分析及其元数据
+// 模型列表为空时表示支持该维度上的所有取值。
+// 同名的分析可以注册多次(如EDF和FTP两种版本), 只要它们支持的模型互不相交。
+class AnalysisInfo{
+
+    public:
+
+    std::string name;                           // 分析名称, 也是结果中的名称
+    std::vector<SchedulingType_t> sTypes;       // 支持的调度类型
+    std::vector<DeadlinesType_t> dTypes;        // 支持的截止时间类型
+    std::vector<AlgorithmType_t> aTypes;        // 支持的调度算法
+    std::vector<DAGType_t> DAGTypes;            // 支持的DAG类型
+    bool singleDAG          = false;            // 是否只能分析单个DAG任务
+    bool needsPartitioning  = false;            // 是否需要先将子任务分配到处理器
+    bool parallelSafe       = true;             // 是否可以与其他分析在同一任务集上并发执行
+    CostClass_t cost        = CostClass_t::MEDIUM;  // 代价等级
+    analysisFunc_t run;                         // 分析入口
+
+    // 是否支持gp描述的任务集模型
+    bool supports(const GeneratorParams& gp) const;
+};
+
+// 分析注册表
+// 内置的分析在第一次访问时按固定顺序注册, 评估时根据生成参数中的模型和选择条件生成运行计划。
+class AnalysisRegistry{
+
+    std::vector<AnalysisInfo> analyses;
+
+    AnalysisRegistry();
+
+    public:
+
+    static AnalysisRegistry& instance();
+
+    void add(const AnalysisInfo& a);
+    const std::vector<AnalysisInfo>& getAnalyses() const {return analyses;}
+    bool contains(const std::string& name) const;
+
+    // 运行计划: 支持gp的模型、在gp.analyses中被选中(为空时全部选中)且代价不超过gp.maxCost的分析, 按注册顺序排列
+    std::vector<const AnalysisInfo*> buildPlan(const GeneratorParams& gp) const;
+};
+
+}
+
+#endif /* ANALYSISREGISTRY_H */
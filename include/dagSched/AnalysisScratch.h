@@ -0,0 +1,49 @@
+#ifndef ANALYSISSCRATCH_H
+#define ANALYSISSCRATCH_H
+
+#include <vector>
+#include "dagSched/Taskset.h"
+
+namespace dagSched{
+
+// 单个任务中每个顶点的分析临时状态, 下标为顶点索引
+class VertexScratch{
+
+    public:
+
+    std::vector<Time_t> r;      // 子任务响应时间
+    std::vector<Time_t> localO; // 本地偏移量(最早开始时间)
+    std::vector<Time_t> localD; // 本地截止时间(最晚完成时间)
+    std::vector<Time_t> EFT;    // 最早完成时间
+    std::vector<Time_t> LST;    // 最晚开始时间
+    std::vector<int> prio;      // 子任务优先级
+};
+
+// 一次分析的临时状态
+// 任务图在分析之间共享且只读, 分析过程中每个顶点的中间结果写入各自的临时缓冲区,
+// 因此多个分析可以在同一任务集上并发执行。下标与构造时任务集中的任务顺序一致,
+// 若分析对任务排序, 应在排序之后构造。
+class AnalysisScratch{
+
+    std::vector<VertexScratch> tasks;
+
+    public:
+
+    AnalysisScratch(){};
+    explicit AnalysisScratch(const Taskset& taskset){
+        tasks.resize(taskset.tasks.size());
+        for(size_t x=0; x<taskset.tasks.size(); ++x){
+            const int n = taskset.tasks[x].getVertices().size();
+            tasks[x].r.assign(n, 0);
+            tasks[x].prio.assign(n, 0);
+        }
+    };
+
+    VertexScratch& operator[](const int x) {return tasks[x];}
+    const VertexScratch& operator[](const int x) const {return tasks[x];}
+    int size() const {return tasks.size();}
+};
+
+}
+
+#endif /* ANALYSISSCRATCH_H */
@@ -0,0 +1,69 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstdint>
+
+namespace dagSched{
+
+// 按64位字打包的位集合工具函数, 位集合以连续的字数组表示
+
+typedef uint64_t bitword_t;
+
+// 容纳n位所需的字数
+inline int bitsetWords(const int n){
+    return (n + 63) >> 6;
+}
+
+// 测试第i位
+inline bool bitsetTest(const bitword_t* b, const int i){
+    return (b[i >> 6] >> (i & 63)) & 1;
+}
+
+// 置位第i位
+inline void bitsetSet(bitword_t* b, const int i){
+    b[i >> 6] |= bitword_t(1) << (i & 63);
+}
+
+// dst |= src
+inline void bitsetOr(bitword_t* dst, const bitword_t* src, const int words){
+    for(int w=0; w<words; ++w)
+        dst[w] |= src[w];
+}
+
+// dst = a & ~b, dst可以与a相同
+inline void bitsetAndNot(bitword_t* dst, const bitword_t* a, const bitword_t* b, const int words){
+    for(int w=0; w<words; ++w)
+        dst[w] = a[w] & ~b[w];
+}
+
+// 统计置位数量
+inline int bitsetCount(const bitword_t* b, const int words){
+    int count = 0;
+    for(int w=0; w<words; ++w)
+        count += __builtin_popcountll(b[w]);
+    return count;
+}
+
+// 按升序遍历所有置位, 对每个位下标调用f
+template<typename F>
+inline void bitsetForEach(const bitword_t* b, const int words, F f){
+    for(int w=0; w<words; ++w){
+        bitword_t word = b[w];
+        while(word){
+            f((w << 6) + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+// 按升序累加置位对应的权重, 与按升序遍历std::set求和的浮点结果一致
+template<typename T>
+inline T bitsetSum(const bitword_t* b, const int words, const T* weight){
+    T sum = 0;
+    bitsetForEach(b, words, [&](const int i){ sum += weight[i]; });
+    return sum;
+}
+
+}
+
+#endif /* BITSET_H */
@@ -0,0 +1,48 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <vector>
+#include "dagSched/SubTask.h"
+
+namespace dagSched{
+
+// DAG的压缩稀疏行(CSR)表示
+// 后继与前驱分别存放在连续的偏移数组和邻居数组中，WCET存放在并行数组中，
+// 顶点i的后继为 succIdx[succOffset[i] .. succOffset[i+1])，前驱同理。
+// 邻居的顺序与SubTask::succ / SubTask::pred中的顺序一致。
+class CSRGraph{
+
+    public:
+
+    std::vector<int> succOffset;    // 后继偏移数组, 大小为|V|+1
+    std::vector<int> succIdx;       // 后继顶点索引
+    std::vector<int> predOffset;    // 前驱偏移数组, 大小为|V|+1
+    std::vector<int> predIdx;       // 前驱顶点索引
+    std::vector<Time_t> c;          // 顶点WCET(与顶点索引对齐)
+
+    CSRGraph(){};
+    explicit CSRGraph(const std::vector<SubTask*>& V){ build(V); };
+
+    // 从指针图构建CSR(要求顶点ID与索引一致)
+    void build(const std::vector<SubTask*>& V);
+
+    // 顶点数量
+    int size() const {return c.size();}
+
+    // 后继/前驱的遍历区间
+    const int* succBegin(const int i) const {return succIdx.data() + succOffset[i];}
+    const int* succEnd(const int i) const {return succIdx.data() + succOffset[i+1];}
+    const int* predBegin(const int i) const {return predIdx.data() + predOffset[i];}
+    const int* predEnd(const int i) const {return predIdx.data() + predOffset[i+1];}
+
+    // 出度/入度
+    int outDegree(const int i) const {return succOffset[i+1] - succOffset[i];}
+    int inDegree(const int i) const {return predOffset[i+1] - predOffset[i];}
+
+    // Kahn算法计算一个拓扑序, 图中存在环时返回false
+    bool kahnOrder(std::vector<int>& order) const;
+};
+
+}
+
+#endif /* CSRGRAPH_H */
@@ -0,0 +1,52 @@
+#ifndef CORETABLE_H
+#define CORETABLE_H
+
+#include <vector>
+#include "dagSched/Taskset.h"
+#include "dagSched/AnalysisScratch.h"
+
+namespace dagSched{
+
+// 分区调度分析使用的[任务][处理器]表
+// 在一次分析开始时从任务集(排序之后)构建, 每个(任务, 处理器)的数据存放在连续数组的
+// x * nCores + core 位置; 每个处理器上的顶点与CSRGraph一样以偏移数组和顶点数组表示,
+// 按顶点索引升序。干扰的计算只读这些数组, 不再遍历任务的所有顶点, 也不分配内存。
+// 超出范围的处理器(未分配的顶点)视为没有顶点。
+class CoreTable{
+
+    int nTasks = 0;
+    int nCores = 0;
+
+    std::vector<Time_t> vol;        // 分区体积, 与DAGTask::getpVolume(core)相同
+    std::vector<int> vertOffset;    // 顶点偏移数组, 大小为nTasks * nCores + 1
+    std::vector<int> vertIdx;       // 按(任务, 处理器)分组的顶点索引
+    std::vector<Time_t> maxR;       // 处理器上顶点的最大响应时间, 没有顶点时为0
+
+    int slot(const int x, const int core) const {return x * nCores + core;}
+    bool inRange(const int core) const {return core >= 0 && core < nCores;}
+
+    public:
+
+    CoreTable(){};
+    explicit CoreTable(const Taskset& taskset){ build(taskset); };
+
+    // 从任务集构建体积和顶点表, 处理器数量为顶点中最大的处理器ID加1
+    void build(const Taskset& taskset);
+
+    // 从scratch中的子任务响应时间重新计算maxR, 响应时间改变后(如每次迭代开始时)调用
+    void updateMaxResponse(const AnalysisScratch& scratch);
+
+    int cores() const {return nCores;}
+
+    Time_t volume(const int x, const int core) const {return inRange(core) ? vol[slot(x, core)] : 0;}
+    Time_t maxResponse(const int x, const int core) const {return inRange(core) ? maxR[slot(x, core)] : 0;}
+    bool hasVertices(const int x, const int core) const {return verticesBegin(x, core) != verticesEnd(x, core);}
+
+    // 任务x分配到core上的顶点的遍历区间
+    const int* verticesBegin(const int x, const int core) const {return inRange(core) ? vertIdx.data() + vertOffset[slot(x, core)] : nullptr;}
+    const int* verticesEnd(const int x, const int core) const {return inRange(core) ? vertIdx.data() + vertOffset[slot(x, core) + 1] : nullptr;}
+};
+
+}
+
+#endif /* CORETABLE_H */
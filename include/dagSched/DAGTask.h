@@ -5,45 +5,104 @@
 #include <map>
 #include <cmath>
 #include <cstdlib>
-#include <random>
 #include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <atomic>
 
 #include <yaml-cpp/yaml.h>
 #include "dagSched/SubTask.h"
+#include "dagSched/VertexArena.h"
+#include "dagSched/CSRGraph.h"
+#include "dagSched/ReachabilityMatrix.h"
+#include "dagSched/PathEnumerator.h"
 #include "dagSched/utils.h"
 #include "dagSched/GeneratorParams.h"
 
 namespace dagSched{
    
+struct workloadArtifactCache;  // Fonseca分析的工作负载分布缓存, 见WorkloadArtifacts.h
+
 // 任务创建状态枚举
 enum creationStates {CONDITIONAL_T=0, PARALLEL_T=1, TERMINAL_T=2};
 
+// 共享顶点的修改计数, 由共享同一组顶点的任务副本共同持有
+// any在任一计数增加时增加, 使副本只需比较一个计数即可判断是否需要同步
+struct vertexVersions{
+    std::atomic<unsigned> any{0};           // 任一修改
+    std::atomic<unsigned> graph{0};         // 边的修改(可达性改变)
+    std::atomic<unsigned> wcet{0};          // WCET的修改
+    std::atomic<unsigned> assignment{0};    // 核心与核心类型分配的修改
+};
+
 // DAG任务类，表示一个有向无环图任务
+// 任务按值复制时副本共享顶点(浅复制)。通过任一副本的方法修改共享顶点(设置WCET、核心或核心类型,
+// 添加或删除边, 传递约简等)会增加共享的修改计数, 其他副本在下次获取派生指标或缓存时失效并重新计算,
+// 因此所有副本都看到修改后的结果。cloneVertices、setVertices和destroyVerices使副本不再共享顶点,
+// 此后各自的修改互不影响。直接通过getVertices()返回的指针修改顶点不会被记录。
 class DAGTask{
 
     std::vector<SubTask*> V;  // 子任务顶点集合
+    std::shared_ptr<VertexArena> arena;  // 顶点内存池, 在任务副本之间共享
 
     // 任务参数
-    float t = 0;          // 周期(period)
-    float d = 0;          // 截止时间(deadline)
-    float L = 0;          // 最长链长度(longest chain)
-    float vol  = 0;       // 总体积(volume)
-    float wcw = 0;        // 最坏情况工作负载(worst case workload)
-    float delta = 0;      // 密度(density)
-    float u = 0;          // 利用率(utilization)
+    Time_t t = 0;         // 周期(period)
+    Time_t d = 0;         // 截止时间(deadline)
 
     std::vector<int> ordIDs;        // 拓扑排序后的ID序列
-    std::map<int, float> typedVol;  // 按核心类型分类的体积 [核心类型, 体积]
-    std::map<int, float> pVol;      // 按分区分类的体积 [核心ID, 体积]
+    std::vector<int> topoLevels;    // 顶点的拓扑层次(从源点出发的最长路径边数)
+
+    // 派生指标, 首次获取时计算并缓存, 由dirty中对应的标志位记录是否过期
+    // 利用率与密度由wcw/t与L/d直接得到, 不单独缓存
+    enum dirtyFlags_t { LENGTH_D = 1, VOLUME_D = 2, WCW_D = 4, TYPED_VOL_D = 8, P_VOL_D = 16,
+                        OFFSETS_D = 32, DEADLINES_D = 64, ALL_D = 127 };
+    mutable int dirty = ALL_D;
+    mutable Time_t L = 0;         // 最长链长度(longest chain)
+    mutable Time_t vol  = 0;      // 总体积(volume)
+    mutable Time_t wcw = 0;       // 最坏情况工作负载(worst case workload)
+    mutable std::map<int, Time_t> typedVol;  // 按核心类型分类的体积 [核心类型, 体积]
+    mutable std::map<int, Time_t> pVol;      // 按分区分类的体积 [核心ID, 体积]
+    mutable std::vector<Time_t> localO;      // 本地偏移量, 按顶点索引排列
+    mutable std::vector<Time_t> EFT;         // 最早完成时间
+    mutable std::vector<Time_t> localD;      // 本地截止时间
+    mutable std::vector<Time_t> LST;         // 最晚开始时间
+
+    // 图结构缓存, 在任务副本之间共享, 图结构或WCET改变时失效
+    mutable std::shared_ptr<const CSRGraph> csr;   // CSR邻接表示
+    mutable std::shared_ptr<ReachabilityMatrix> reach;   // 可达性矩阵(传递闭包), 只被本副本持有时随边的增删增量更新
+    // 工作负载分布缓存, 缓存对象本身在任务副本之间共享, 任一副本计算的结果对其他副本可见;
+    // 图结构或WCET改变时丢弃, 需要时创建新的缓存对象
+    mutable std::shared_ptr<workloadArtifactCache> artifacts;
+
+    // 共享顶点的修改计数, 在共享顶点的任务副本之间共享; 本副本已处理的各计数值
+    std::shared_ptr<vertexVersions> versions;
+    mutable unsigned seenAny = 0, seenGraph = 0, seenWCET = 0, seenAssignment = 0;
+
+    void invalidateGraph(); // 使图结构缓存及所有派生指标失效
+    void invalidateWCET(); // WCET改变: 使CSR及所有派生指标失效, 可达性不变
+    void ownVertices(); // 使用新的修改计数, 不再与其他副本共享
+    void recordChange(std::atomic<unsigned>& counter, unsigned& seen); // 记录对共享顶点的一次修改
+    void syncShared() const; // 按其他副本的修改使本副本的缓存失效
+    std::shared_ptr<ReachabilityMatrix> takeReachability(); // 可达性矩阵只被本副本持有时取出以便增量更新, 否则返回空
+    void checkShared() const { if(versions && versions->any.load(std::memory_order_relaxed) != seenAny) syncShared(); }
+    const std::vector<int>& topologicalOrder(std::vector<int>& tmp) const; // 已排序时返回ordIDs, 否则在tmp中计算
+
+    // 重新计算对应的派生指标并清除其标志位
+    void updateLength() const;
+    void updateVolume() const;
+    void updateWorstCaseWorkload() const;
+    void updateTypedVolume() const;
+    void updatepVolume() const;
+    void updateOffsets() const;
+    void updateDeadlines() const;
 
     public:
 
-    float R = 0;          // 响应时间(response time)
+    Time_t R = 0;         // 响应时间(response time)
 
     DAGTask(){};
-    DAGTask(const float T, const float D): t(T), d(D) {};
+    DAGTask(const Time_t T, const Time_t D): t(T), d(D) {};
     ~DAGTask(){};
 
     // 输入输出操作
@@ -53,10 +112,12 @@ class DAGTask{
     friend std::ostream& operator<<(std::ostream& os, const DAGTask& t); // 输出运算符重载
 
     // DAG操作
+    SubTask* createSubTask(); // 在任务的顶点内存池中创建子任务
     void cloneVertices(const std::vector<SubTask*>& to_clone_V); // 克隆顶点
     void destroyVerices(); // 销毁顶点
+    void addEdge(SubTask* from, SubTask* to); // 添加边 from -> to
+    void removeEdge(SubTask* from, SubTask* to); // 删除边 from -> to
     void isSuccessor(const SubTask* v, const SubTask *w, bool &is_succ) const; // 判断后继关系
-    bool allPrecAdded(std::vector<SubTask*> pred, std::vector<int> ids); // 检查所有前驱是否已添加
     void topologicalSort(); // 拓扑排序
     bool checkIndexAndIdsAreEqual(); // 检查索引和ID是否匹配
     void computeAccWorkload(); // 计算累计工作负载
@@ -67,8 +128,9 @@ class DAGTask{
     void computeWorstCaseWorkload(); // 计算最坏情况工作负载
     void computeUtilization(); // 计算利用率
     void computeDensity(); // 计算密度
-    std::vector<std::vector<int>> computeAllPathsSingleSource(std::vector<int>& path, std::vector<std::vector<int>>& all_paths) const; // 计算所有路径(单源)
-    std::vector<std::vector<int>> computeAllPaths() const; // 计算所有路径
+    void computeMetrics(); // 计算所有派生指标, 使任务副本无需再计算
+    std::vector<std::vector<int>> computeAllPaths() const; // 计算所有路径(路径较多时应使用PathEnumerator逐条处理)
+    double countPaths() const {return PathEnumerator::count(getCSR());}; // 计算路径总数
 
     // 时间分析相关方法
     void localDeadline(SubTask *task, const int i); // 计算本地截止时间
@@ -78,37 +140,60 @@ class DAGTask{
     void computeEFTs(); // 计算最早完成时间
     void computeLSTs(); // 计算最晚开始时间
 
+    // 时间分析的只读版本, 结果写入按顶点索引排列的数组而不修改顶点
+    void computeLocalOffsets(std::vector<Time_t>& localO) const;
+    void computeLocalDeadlines(std::vector<Time_t>& localD) const;
+    void computeEFTs(std::vector<Time_t>& localO, std::vector<Time_t>& EFT) const;
+    void computeLSTs(std::vector<Time_t>& localD, std::vector<Time_t>& LST) const;
+
     // 获取顶点关系
     std::vector<SubTask*> getSubTaskAncestors(const int i) const; // 获取祖先顶点
     std::vector<SubTask*> getSubTaskDescendants(const int i) const; // 获取后代顶点
     void transitiveReduction(); // 传递约简
+    void buildCSR(); // 构建CSR邻接表示
 
     // 获取方法
-    float getLength() const {return L;}; // 获取最长链长度
-    float getVolume() const {return vol;}; // 获取总体积
-    std::map<int, float> getTypedVolume() const {return typedVol;}; // 获取类型化体积
-    std::map<int, float> getpVolume() const {return pVol;}; // 获取分区体积
-    float getWorstCaseWorkload() const {return wcw;}; // 获取最坏情况工作负载
-    float getWCW() const {return wcw;}; // 获取最坏情况工作负载(别名)
-    float getPeriod() const {return t;}; // 获取周期
-    float getDeadline() const {return d;}; // 获取截止时间
-    float getUtilization() const {return u;}; // 获取利用率
-    float getDensity() const {return delta;}; // 获取密度
+    // 派生指标在过期时(包括其他副本修改了共享顶点时)按需计算;
+    // 按需计算会修改缓存, 同一任务对象不应被多个线程同时首次访问
+    Time_t getLength() const {checkShared(); if(dirty & LENGTH_D) updateLength(); return L;}; // 获取最长链长度
+    Time_t getVolume() const {checkShared(); if(dirty & VOLUME_D) updateVolume(); return vol;}; // 获取总体积
+    const std::map<int, Time_t>& getTypedVolume() const {checkShared(); if(dirty & TYPED_VOL_D) updateTypedVolume(); return typedVol;}; // 获取类型化体积
+    const std::map<int, Time_t>& getpVolume() const {checkShared(); if(dirty & P_VOL_D) updatepVolume(); return pVol;}; // 获取分区体积
+    Time_t getpVolume(const int core) const; // 获取某核心上的分区体积, 无顶点时为0
+    Time_t getWorstCaseWorkload() const {return getWCW();}; // 获取最坏情况工作负载
+    Time_t getWCW() const {checkShared(); if(dirty & WCW_D) updateWorstCaseWorkload(); return wcw;}; // 获取最坏情况工作负载(别名)
+    const std::vector<Time_t>& getLocalOffsets() const {checkShared(); if(dirty & OFFSETS_D) updateOffsets(); return localO;}; // 获取本地偏移量
+    const std::vector<Time_t>& getEFTs() const {checkShared(); if(dirty & OFFSETS_D) updateOffsets(); return EFT;}; // 获取最早完成时间
+    const std::vector<Time_t>& getLocalDeadlines() const {checkShared(); if(dirty & DEADLINES_D) updateDeadlines(); return localD;}; // 获取本地截止时间
+    const std::vector<Time_t>& getLSTs() const {checkShared(); if(dirty & DEADLINES_D) updateDeadlines(); return LST;}; // 获取最晚开始时间
+    Time_t getPeriod() const {return t;}; // 获取周期
+    Time_t getDeadline() const {return d;}; // 获取截止时间
+    float getUtilization() const {return (float) getWCW() / t;}; // 获取利用率
+    float getDensity() const {return (float) getLength() / d;}; // 获取密度
     std::vector<int> getTopologicalOrder() const {return ordIDs;}; // 获取拓扑排序
-    std::vector<SubTask*> getVertices() const {return V;}; // 获取顶点集合
+    const std::vector<int>& getTopologicalLevels() const {return topoLevels;}; // 获取拓扑层次
+    const std::vector<SubTask*>& getVertices() const {return V;}; // 获取顶点集合
+    const CSRGraph& getCSR() const; // 获取CSR邻接表示(未构建时按需构建)
+    const ReachabilityMatrix& getReachability() const; // 获取可达性矩阵(未构建时按需构建)
+    workloadArtifactCache& getArtifactCache() const; // 获取工作负载分布缓存(不存在时创建)
+    void resetArtifactCache() { artifacts.reset(); } // 不再使用共享的工作负载分布缓存, 其他副本的缓存不受影响
 
     // 设置方法
-    void setVertices(std::vector<SubTask*> given_V){ V.clear(); V = given_V; } // 设置顶点集合
-    void setDeadline(const float deadline) { d = deadline; } // 设置截止时间
-    void setPeriod(const float period) { t = period; } // 设置周期
+    void setVertices(std::vector<SubTask*> given_V){ ownVertices(); V.clear(); V = given_V; invalidateGraph(); } // 设置顶点集合, 不再与其他副本共享
+    void setDeadline(const Time_t deadline) { d = deadline; dirty |= DEADLINES_D; } // 设置截止时间
+    void setPeriod(const Time_t period) { t = period; } // 设置周期
+    // 子任务的设置对共享顶点的所有任务副本可见
+    void setSubTaskWCET(const int i, const Time_t c) { V[i]->c = c; invalidateWCET(); } // 设置子任务WCET
+    void setSubTaskCore(const int i, const int core); // 设置子任务分配的核心
+    void setSubTaskType(const int i, const int gamma); // 设置子任务核心类型
 
     // Melani生成方法
-    void assignWCET(const int minC, const int maxC); // 分配最坏执行时间
-    void expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int depth,const int numBranches, const bool ifCond, GeneratorParams& gp); // 扩展串并行任务
-    void makeItDag(float prob); // 转换为DAG
+    void assignWCET(const int minC, const int maxC, RandomStream& rng); // 分配最坏执行时间
+    void expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int depth,const int numBranches, const bool ifCond, const GeneratorParams& gp, RandomStream& rng); // 扩展串并行任务
+    void makeItDag(float prob, RandomStream& rng); // 转换为DAG
     void assignSchedParametersUUniFast(const float U); // 使用UUniFast分配调度参数
-    void assignSchedParameters(const float beta); // 分配调度参数
-    void assignFixedSchedParameters(const float period, const float deadline); // 分配固定调度参数
+    void assignSchedParameters(const float beta, RandomStream& rng); // 分配调度参数
+    void assignFixedSchedParameters(const Time_t period, const Time_t deadline); // 分配固定调度参数
 };
 
 // DAG比较函数
@@ -0,0 +1,53 @@
+#ifndef EVALCHECKPOINT_H
+#define EVALCHECKPOINT_H
+
+#include <set>
+#include <string>
+#include <cstdint>
+
+namespace dagSched{
+
+// 评估进度: 已完成的任务集集合
+// 任务集并行分析, 完成顺序不固定, 因此保存一个前缀加上前缀之后零散完成的任务集,
+// 零散部分的大小不超过同时分析的任务集数量。
+class EvalProgress{
+
+    int doneBelow = 0;          // 索引小于doneBelow的任务集都已完成
+    std::set<int> doneAbove;    // 索引不小于doneBelow的已完成任务集
+
+    public:
+
+    void markDone(const int i);
+    bool isDone(const int i) const {return i < doneBelow || doneAbove.count(i);}
+    int nDone() const {return doneBelow + doneAbove.size();}
+
+    friend class EvalCheckpoint;
+};
+
+// 评估的检查点
+// 任务集由(种子, 扫描点, 任务集索引)确定的随机数流生成, 因此无需保存生成器状态;
+// 结果已经写入结果文件, 检查点只记录哪些任务集已完成以及此时结果文件的长度,
+// 恢复时将结果文件截断到该长度, 丢弃检查点之后写入的行, 再跳过已完成的任务集。
+class EvalCheckpoint{
+
+    public:
+
+    uint64_t configHash     = 0;    // 生成参数文件内容的哈希值
+    uint64_t seed           = 0;    // 随机数种子
+    int nTasksets           = 0;    // 任务集总数
+    uint64_t resultsSize    = 0;    // 检查点时结果文件的字节数
+    EvalProgress progress;
+
+    // 先写入临时文件再重命名, 中断时不会留下不完整的检查点
+    void save(const std::string& path) const;
+
+    // 检查点文件不存在时返回false
+    bool load(const std::string& path);
+};
+
+// 文件内容的FNV-1a哈希值, 用于确认恢复时使用的是同一份参数
+uint64_t hashFileContent(const std::string& path);
+
+}
+
+#endif /* EVALCHECKPOINT_H */
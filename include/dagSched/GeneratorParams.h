@@ -5,10 +5,11 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
-#include <random>
+#include <ctime>
 #include <yaml-cpp/yaml.h>
 
 #include "dagSched/utils.h"
+#include "dagSched/RandomStream.h"
 
 namespace dagSched{
 
@@ -47,6 +48,12 @@ enum workloadType_t {SINGLE_DAG, TASKSET};
 // TDAG: 类型化有向无环图
 enum DAGType_t {DAG, CDAG, TDAG};
 
+// 分析代价等级枚举
+// CHEAP: 闭式的充分条件
+// MEDIUM: 响应时间的不动点迭代
+// EXPENSIVE: 枚举路径或调用外部工具
+enum CostClass_t {CHEAP, MEDIUM, EXPENSIVE};
+
 // DAG生成参数类
 // 用于配置生成DAG的各种参数
 class GeneratorParams{
@@ -111,20 +118,28 @@ class GeneratorParams{
     workloadType_t wType    = workloadType_t::TASKSET;      // 工作负载类型
     DAGType_t DAGType       = DAGType_t::DAG;               // DAG类型
 
-    // 随机分布相关
-    std::discrete_distribution<int> dist;  // 分支添加分布
-    std::vector<double> weights;          // 权重向量
-    std::mt19937 gen;                      // 随机数生成器
+    // 分析选择
+    std::vector<std::string> analyses;      // 要运行的分析名称, 为空时运行所有支持该模型的分析
+    CostClass_t maxCost     = CostClass_t::EXPENSIVE;   // 允许的最高代价等级
+    float timeout           = 0;        // 每个分析在每个任务集上的时间上限(秒), 0为不限制
+    uint64_t maxIterations  = 0;        // 每个分析在每个任务集上的迭代次数上限, 0为不限制
+    bool perfCounters       = false;    // 是否用硬件性能计数器测量每个分析
+
+    // 随机数相关
+    std::vector<double> weights;            // 条件/并行/终止分支的权重向量
+    uint64_t seed           = 1;            // 随机数流的种子
 
     // 配置参数方法
     void configureParams(GenerationType_t gt){
         gType = gt;
 
+        // 设置随机种子
+        if(!REPRODUCIBLE) seed = time(0);
+
         // 设置权重向量
         weights.push_back(pCond);
         weights.push_back(pPar);
         weights.push_back(pTerm);
-        dist.param(std::discrete_distribution<int> ::param_type(std::begin(weights), std::end(weights)));
 
         // 根据生成类型设置任务集数量
         switch (gt){
@@ -148,18 +163,15 @@ class GeneratorParams{
 
         // 类型化DAG的特殊处理
         if(DAGType != DAGType_t::TDAG){
+            RandomStream rng(seed, RandomStream::PARAMS_STREAM);
             typedProc.resize(diffProcTypes);
             for(int p=0; p<typedProc.size(); ++p)
-                typedProc[p] = rand () % maxProcPerType + minProcPerType;
+                typedProc[p] = rng.intRandMaxMin(minProcPerType, minProcPerType + maxProcPerType);
         }
 
         // 单个DAG的特殊处理
         if(wType == workloadType_t::SINGLE_DAG)
             nTasks = 1;
-        
-        // 设置随机种子
-        if(REPRODUCIBLE) gen.seed(1);
-        else gen.seed(time(0));
     }
 
     // 从YAML文件读取参数
@@ -202,6 +214,12 @@ class GeneratorParams{
         if(config["aType"]) aType = (AlgorithmType_t) config["aType"].as<int>();
         if(config["wType"]) wType = (workloadType_t) config["wType"].as<int>();
         if(config["DAGType"]) DAGType = (DAGType_t) config["DAGType"].as<int>();
+        if(config["seed"]) seed = config["seed"].as<uint64_t>();
+        if(config["analyses"]) analyses = config["analyses"].as<std::vector<std::string>>();
+        if(config["maxCost"]) maxCost = (CostClass_t) config["maxCost"].as<int>();
+        if(config["timeout"]) timeout = config["timeout"].as<float>();
+        if(config["maxIterations"]) maxIterations = config["maxIterations"].as<uint64_t>();
+        if(config["perfCounters"]) perfCounters = config["perfCounters"].as<bool>();
     }
 
     // 打印参数
@@ -241,6 +259,15 @@ class GeneratorParams{
         std::cout<<"aType: "<<aType<<std::endl;
         std::cout<<"wType: "<<wType<<std::endl;
         std::cout<<"DAGType: "<<DAGType<<std::endl;
+        std::cout<<"seed: "<<seed<<std::endl;
+        std::cout<<"analyses:";
+        for(const auto& a: analyses)
+            std::cout<<" "<<a;
+        std::cout<<std::endl;
+        std::cout<<"maxCost: "<<maxCost<<std::endl;
+        std::cout<<"timeout: "<<timeout<<std::endl;
+        std::cout<<"maxIterations: "<<maxIterations<<std::endl;
+        std::cout<<"perfCounters: "<<perfCounters<<std::endl;
     }
 };
 
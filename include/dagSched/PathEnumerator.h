@@ -0,0 +1,51 @@
+#ifndef PATHENUMERATOR_H
+#define PATHENUMERATOR_H
+
+#include <vector>
+#include "dagSched/CSRGraph.h"
+
+namespace dagSched{
+
+// 按需枚举DAG中从源点(无前驱)到汇点(无后继)的所有路径
+// 使用显式栈进行深度优先遍历, 当前路径保存在同一个缓冲区中, 枚举过程中不为每条路径分配内存。
+// 源点按索引升序、后继按CSR中的顺序访问, 因此路径的顺序与递归枚举的顺序一致。
+// 用法:
+//     PathEnumerator paths(task.getCSR());
+//     while(paths.next())
+//         use(paths.path());
+class PathEnumerator{
+
+    const CSRGraph& g;
+
+    std::vector<int> cur;       // 当前路径上的顶点
+    std::vector<int> edge;      // 每层下一个待访问的后继在succIdx中的位置
+    int nextSource = 0;         // 下一个待访问的源点
+    bool started = false;       // 是否已经开始枚举
+
+    bool descend();             // 从当前路径的末端沿第一条后继一直走到汇点
+
+    public:
+
+    explicit PathEnumerator(const CSRGraph& graph): g(graph) {};
+
+    // 前进到下一条路径, 没有更多路径时返回false
+    bool next();
+
+    // 当前路径, 在下一次调用next()之前有效
+    const std::vector<int>& path() const {return cur;}
+
+    // 对每条路径调用f(const std::vector<int>&)
+    template<typename F>
+    void forEach(F f){
+        while(next())
+            f(cur);
+    }
+
+    // 用动态规划计算路径总数, 复杂度O(V+E)
+    // 路径数随图的规模可能呈指数增长, 因此用double表示
+    static double count(const CSRGraph& g);
+};
+
+}
+
+#endif /* PATHENUMERATOR_H */
@@ -0,0 +1,96 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <map>
+#include <array>
+#include <string>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+namespace dagSched{
+
+// 硬件/软件性能计数器
+enum PerfEvent_t {CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, PAGE_FAULTS, N_PERF_EVENTS};
+
+// 计数器名称, 用于输出
+const char* perfEventName(const PerfEvent_t e);
+
+// 一次测量的计数值, 无法打开的计数器valid为false
+struct perfSample{
+    std::array<uint64_t, N_PERF_EVENTS> value {};
+    std::array<bool, N_PERF_EVENTS> valid {};
+};
+
+// 基于perf_event_open的计数器, 只统计调用线程在用户态的事件
+// 每个计数器单独打开, 内核或虚拟机不支持的计数器(或权限不足时)被跳过, 其余照常计数;
+// 计数器被复用时按实际计数时间的比例放大。非Linux系统上所有计数器都不可用。
+class PerfCounters{
+
+    std::array<int, N_PERF_EVENTS> fd;
+
+    public:
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // 是否至少有一个计数器可用
+    bool available() const;
+
+    // 清零并开始计数
+    void start();
+    // 停止计数并返回从start()开始的计数值
+    perfSample stop();
+
+    // 调用线程的计数器, 第一次调用时打开, 线程结束时关闭
+    static PerfCounters& threadCounters();
+};
+
+// 一个分析的计数器累计值
+struct perfStats{
+    uint64_t calls = 0;                                 // 测量次数
+    std::array<uint64_t, N_PERF_EVENTS> sum {};         // 每个计数器的总和
+    std::array<uint64_t, N_PERF_EVENTS> validCalls {};  // 每个计数器有效的测量次数
+};
+
+// 按分析名称累计计数器, 线程安全
+class PerfAggregator{
+
+    std::map<std::string, perfStats> stats;
+    mutable std::mutex mtx;
+
+    public:
+
+    void add(const std::string& name, const perfSample& sample);
+
+    std::map<std::string, perfStats> getStats() const;
+
+    // 打印每个分析每次调用的平均计数值, 以及IPC和每千条指令的缓存/分支未命中数
+    void print(std::ostream& os) const;
+
+    // 以CSV格式保存累计值: test,calls,<计数器>..., 不可用的计数器为空
+    void save(const std::string& path) const;
+};
+
+// 在作用域内测量调用线程的计数器, 析构时把结果加入aggregator
+// aggregator为nullptr时不做任何事, 因此可以无条件地放在分析调用的周围
+class PerfScope{
+
+    PerfAggregator* aggregator;
+    std::string name;
+
+    public:
+
+    PerfScope(PerfAggregator* aggregator, const std::string& name);
+    ~PerfScope();
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+};
+
+}
+
+#endif /* PERFCOUNTERS_H */
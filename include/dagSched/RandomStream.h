@@ -0,0 +1,94 @@
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace dagSched{
+
+// 基于计数器的随机数流
+// 第k个随机数由(密钥, k)经过SplitMix64的混合函数直接计算得到, 不依赖任何全局状态。
+// 密钥由(种子, 扫描点, 任务集索引)派生, 因此每个任务集都有独立的随机数流:
+// 任意任务集都可以单独重新生成, 并行或分片运行生成的任务集与串行运行完全相同。
+class RandomStream{
+
+    uint64_t key        = 0;    // 由种子和流索引派生的密钥
+    uint64_t counter    = 0;    // 已抽取的随机数个数
+
+    static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+
+    static uint64_t mix(uint64_t z){
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // 与rand()相同范围[0, 2^31-1]的整数
+    int nextInt(){
+        return (int) ((*this)() >> 33);
+    }
+
+    public:
+
+    typedef uint64_t result_type;
+
+    // 保留的扫描点索引, 用于生成参数本身的随机抽取(如处理器类型数量)
+    static constexpr uint64_t PARAMS_STREAM = UINT64_MAX;
+
+    explicit RandomStream(const uint64_t seed, const uint64_t sweep_point = 0, const uint64_t taskset_idx = 0){
+        key = mix(seed + GAMMA);
+        key = mix(key ^ (sweep_point + GAMMA));
+        key = mix(key ^ (taskset_idx + GAMMA));
+    }
+
+    static constexpr result_type min() {return 0;}
+    static constexpr result_type max() {return UINT64_MAX;}
+
+    // 第counter个随机数, 只依赖密钥和计数器
+    result_type operator()(){
+        return mix(key ^ mix(++counter * GAMMA));
+    }
+
+    // [0,1)范围内的均匀分布随机数
+    double uniform(){
+        return ((*this)() >> 11) * (1. / (UINT64_C(1) << 53));
+    }
+
+    // 生成[min,max]范围内的随机整数
+    int intRandMaxMin(const int v_min, const int v_max){
+        return nextInt() % std::max(v_max - v_min, 1) + v_min;
+    }
+
+    // 生成[min,max]范围内的随机浮点数
+    float floatRandMaxMin(const float v_min, const float v_max){
+        return std::fmod(nextInt(), std::max(v_max - v_min, float(1))) + v_min;
+    }
+
+    // 按权重随机选择一个索引
+    // 不依赖标准库分布的实现, 不同平台上生成的序列一致
+    int discrete(const std::vector<double>& weights){
+        double tot = 0;
+        for(const double w: weights)
+            tot += w;
+
+        const double r = uniform() * tot;
+        double acc = 0;
+        for(int i=0; i<weights.size(); ++i){
+            acc += weights[i];
+            if(r < acc)
+                return i;
+        }
+
+        // 舍入误差时返回最后一个权重非零的索引
+        for(int i=weights.size()-1; i>0; --i)
+            if(weights[i] > 0)
+                return i;
+        return 0;
+    }
+};
+
+}
+
+#endif /* RANDOMSTREAM_H */
@@ -0,0 +1,58 @@
+#ifndef REACHABILITYMATRIX_H
+#define REACHABILITYMATRIX_H
+
+#include <vector>
+#include "dagSched/Bitset.h"
+#include "dagSched/CSRGraph.h"
+
+namespace dagSched{
+
+// DAG的传递闭包, 每个顶点一行按字打包的后代位集合和一行祖先位集合
+// 后代按逆拓扑序、祖先按拓扑序一次性计算, 之后reaches(u,v)为O(1)查询
+class ReachabilityMatrix{
+
+    int n       = 0;    // 顶点数量
+    int words   = 0;    // 每行的字数
+
+    std::vector<bitword_t> desc;    // 后代矩阵, 第u行为u可达的顶点
+    std::vector<bitword_t> ancst;   // 祖先矩阵, 第v行为可达v的顶点
+
+    public:
+
+    ReachabilityMatrix(){};
+    explicit ReachabilityMatrix(const CSRGraph& g){ build(g); };
+
+    // 从CSR图计算传递闭包
+    // redundant: 若非空, 同时标记传递(冗余)边, 下标与g.succIdx对齐
+    void build(const CSRGraph& g, std::vector<char>* redundant = nullptr);
+
+    // 增量添加边u->v并更新传递闭包
+    void addEdge(const int u, const int v);
+
+    // 边u->v已从图中删除后增量更新传递闭包, 只重新计算u及其祖先的后代行、v及其后代的祖先行
+    // V: 删除边之后的顶点集合(顶点ID须与索引一致)
+    void removeEdge(const int u, const int v, const std::vector<SubTask*>& V);
+
+    // 判断v是否为u的后代(u可达v)
+    bool reaches(const int u, const int v) const {return bitsetTest(descendants(u), v);}
+
+    // 获取行数据
+    const bitword_t* descendants(const int u) const {return desc.data() + (size_t)u * words;}
+    const bitword_t* ancestors(const int v) const {return ancst.data() + (size_t)v * words;}
+    int size() const {return n;}
+    int rowWords() const {return words;}
+
+    // 后代/祖先数量
+    int countDescendants(const int u) const {return bitsetCount(descendants(u), words);}
+    int countAncestors(const int v) const {return bitsetCount(ancestors(v), words);}
+
+    // 按顶点索引升序遍历后代/祖先
+    template<typename F>
+    void forEachDescendant(const int u, F f) const { bitsetForEach(descendants(u), words, f); }
+    template<typename F>
+    void forEachAncestor(const int v, F f) const { bitsetForEach(ancestors(v), words, f); }
+};
+
+}
+
+#endif /* REACHABILITYMATRIX_H */
@@ -0,0 +1,95 @@
+#ifndef RESULTSINK_H
+#define RESULTSINK_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace dagSched{
+
+// 评估结果中的一行: 一个任务集上一个分析的结果
+struct resultRow{
+    int taskset     = 0;    // 任务集索引
+    int point       = 0;    // 所属扫描点的索引
+    float x         = 0;    // 扫描点的横坐标
+    int m           = 0;    // 处理器数量
+    int n_tasks     = 0;    // 任务数量
+    float U         = 0;    // 任务集利用率
+    std::string test;       // 分析名称
+    int sched       = 0;    // 可调度性判定(Verdict_t)
+    double time     = 0;    // 分析耗时(微秒)
+    uint64_t allocations    = 0;    // 分析中的分配次数
+    uint64_t bytes          = 0;    // 分析中分配的总字节数
+    uint64_t peakBytes      = 0;    // 分析中同时存活的最大字节数
+};
+
+// 从结果文件中读回的评估结果, 与evaluate()中用于绘图的数据结构一致
+struct evalResults{
+    std::string xLabel;                                 // 横坐标名称
+    std::vector<float> x;                               // 每个扫描点的横坐标
+    std::map<std::string,std::vector<float>> sched;     // 每个分析在每个扫描点上可调度的任务集数
+    std::map<std::string,std::vector<double>> times;    // 每个分析按任务集顺序的耗时
+    std::map<std::string,std::vector<int>> timedOut;    // 每个分析在每个扫描点上超时的任务集数
+    std::map<std::string,uint64_t> peakBytes;           // 每个分析在所有任务集上的最大峰值内存(字节), 只有记录了分配统计的分析
+};
+
+// 评估结果的流式写入器
+// 每行以CSV格式追加写入文件: taskset,point,x,m,n_tasks,U,test,sched,time,allocations,bytes,peak_bytes
+// 编译时没有启用分配统计(allocAccountingEnabled())时最后三列为空。
+// 多个线程可以同时调用write(), 行先在内存缓冲区中累积, 缓冲区满后交给后台线程写入磁盘,
+// 因此分析线程不会等待I/O, 内存中也只保留固定大小的缓冲区。
+// 同一次write()调用中的行在文件中是连续的。
+class ResultSink{
+
+    std::ofstream out;
+
+    std::string buffer;                 // 正在填充的缓冲区
+    std::vector<std::string> full;      // 等待后台线程写入的缓冲区
+    size_t bufferSize;                  // 缓冲区大小(字节)
+    uint64_t written = 0;               // 已写入文件的字节数
+    uint64_t submitted = 0;             // 已提交的行全部写入后文件的字节数
+    bool writing = false;               // 后台线程是否正在写入
+    bool closing = false;               // 是否正在关闭
+
+    std::mutex mtx;
+    std::condition_variable cv;         // 通知后台线程有缓冲区待写入
+    std::condition_variable drained;    // 通知flush()有缓冲区已写入
+    std::thread writer;
+
+    void writerLoop();
+
+    public:
+
+    // append为true时在已有的结果文件后继续追加, 不再写入表头
+    ResultSink(const std::string& path, const std::string& x_label, const bool append = false, const size_t buffer_size = 1 << 16);
+    ~ResultSink();
+
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    // 追加若干行, 线程安全
+    void write(const std::vector<resultRow>& rows);
+
+    // 已提交的行全部写入后文件的字节数, 不等待写入
+    uint64_t size();
+
+    // 等待文件的前n个字节写入完毕(n为之前某次size()的返回值), 之后提交的行不必等待
+    void flush(const uint64_t n);
+
+    // 写入所有剩余的行并关闭文件
+    void close();
+};
+
+// 读取ResultSink写入的结果文件
+// 没有换行符结尾的最后一行(运行中断时写了一半)和数值格式错误的行会被忽略, 文件无法打开时返回false
+// 没有分配统计列的旧结果文件也可以读取
+bool readResults(const std::string& path, evalResults& res);
+
+}
+
+#endif /* RESULTSINK_H */
@@ -92,8 +92,8 @@ class SPTree{
 
     //Fonseca method (2017 & 2019) --------------------------------------------
     std::vector<std::pair<float, float>> computeWDUCO(const DAGTask& dag, const int dag_id);
-    /* Equation 8 Fonseca 2017*/
-    std::vector<int> computeP(  SPNode * node, const std::vector<SubTask*>& V);
+    /* Equation 8 Fonseca 2017, c are the remaining WCETs of the vertices*/
+    std::vector<int> computeP(  SPNode * node, const std::vector<Time_t>& c);
 };
 
 }
@@ -2,6 +2,7 @@
 #define SUBTASK_H
 
 #include <vector>
+#include <memory_resource>
 #include "dagSched/utils.h"
 
 namespace dagSched{
@@ -17,6 +18,9 @@ enum subTaskMode {NORMAL_T, C_INTERN_T, C_SOURCE_T, C_SINK_T};
 class SubTask{
 
     public:
+    SubTask(){};
+    explicit SubTask(std::pmr::memory_resource* mr): succ(mr), pred(mr) {}; // 邻接表使用给定的内存资源
+
     // 基本属性
     int id          = 0;    // 子任务唯一标识符
     int depth       = 0;    // 在DAG中的深度
@@ -26,19 +30,19 @@ class SubTask{
     int prio        = 0;    // 子任务优先级
 
     // 时间相关属性
-    float c         = 0;    // 最坏情况执行时间(WCET)
-    float accWork   = 0;    // 累计工作量
-    float r         = 0;    // 子任务响应时间
-    float localO    = -1;   // 本地偏移量(最早开始时间)
-    float localD    = -1;   // 本地截止时间(最晚完成时间)
-    float EFT       = -1;   // 最早完成时间
-    float LST       = -1;   // 最晚开始时间
+    Time_t c        = 0;    // 最坏情况执行时间(WCET)
+    Time_t accWork  = 0;    // 累计工作量
+    Time_t r        = 0;    // 子任务响应时间
+    Time_t localO   = -1;   // 本地偏移量(最早开始时间)
+    Time_t localD   = -1;   // 本地截止时间(最晚完成时间)
+    Time_t EFT      = -1;   // 最早完成时间
+    Time_t LST      = -1;   // 最晚开始时间
 
     subTaskMode mode = NORMAL_T;    // 节点类型
 
-    // 图结构关系
-    std::vector<SubTask*> succ;     // 后继节点列表
-    std::vector<SubTask*> pred;     // 前驱节点列表
+    // 图结构关系(由所属任务的顶点内存池分配)
+    std::pmr::vector<SubTask*> succ;     // 后继节点列表
+    std::pmr::vector<SubTask*> pred;     // 前驱节点列表
 
     // 获取条件前驱节点ID列表
     std::vector<int> getCondPred();
@@ -48,7 +52,7 @@ class SubTask{
     // 计算最早完成时间
     void EasliestFinishingTime();
     // 计算本地截止时间
-    void localDeadline(const float task_deadline);
+    void localDeadline(const Time_t task_deadline);
     // 计算最晚开始时间
     void LatestStartingTime();
 };
@@ -27,6 +27,7 @@ class Taskset{
     float getMaxDensity() const {return maxDelta;}
 
     //compute on taskset
+    void transitiveReduction(const bool parallel = true);
     void computeUtilization();
     void computeHyperPeriod();
     void computeMaxDensity();
@@ -37,8 +38,8 @@ class Taskset{
     void print() const;
 
     //generate taskset 
-    float UUniFast_Upart(float& sum_U, const int i, const int n_tasks, const DAGTask& t );
-    void generate_taskset_Melani(int n_tasks, const float U_tot, const int n_proc, GeneratorParams& gp);
+    float UUniFast_Upart(float& sum_U, const int i, const int n_tasks, const DAGTask& t, RandomStream& rng);
+    void generate_taskset_Melani(int n_tasks, const float U_tot, const int n_proc, const GeneratorParams& gp, RandomStream& rng);
 };
 
 }
@@ -0,0 +1,36 @@
+#ifndef VERTEXARENA_H
+#define VERTEXARENA_H
+
+#include <new>
+#include <memory_resource>
+#include "dagSched/SubTask.h"
+
+namespace dagSched{
+
+// 子任务顶点内存池
+// 顶点及其邻接表都从同一个单调缓冲区分配, 内存池析构时一次性释放全部内存。
+// 顶点的析构函数不会被调用, 因此顶点不能持有内存池之外的资源。
+class VertexArena{
+
+    std::pmr::monotonic_buffer_resource pool;
+
+    public:
+
+    VertexArena(){};
+    explicit VertexArena(const size_t initial_size): pool(initial_size) {}; // 预分配initial_size字节
+    VertexArena(const VertexArena&) = delete;
+    VertexArena& operator=(const VertexArena&) = delete;
+
+    // 获取内存资源
+    std::pmr::memory_resource* resource() {return &pool;}
+
+    // 在内存池中构造一个空的子任务
+    SubTask* create(){
+        void* p = pool.allocate(sizeof(SubTask), alignof(SubTask));
+        return new (p) SubTask(&pool);
+    }
+};
+
+}
+
+#endif /* VERTEXARENA_H */
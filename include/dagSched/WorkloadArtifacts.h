@@ -0,0 +1,26 @@
+#ifndef WORKLOADARTIFACTS_H
+#define WORKLOADARTIFACTS_H
+
+#include <memory>
+#include <mutex>
+#include "dagSched/WorkloadDistribution.h"
+
+namespace dagSched{
+
+// Fonseca2017/2019分析中只依赖任务图结构和WCET的中间结果
+// EFT已缓存在任务上; SP分解树描述的是转换为NFJ DAG的临时副本, 计算WD_UCO后即失效, 因此都不保存
+struct workloadArtifacts{
+    WorkloadDistribution WD_UCI;        // carry-in工作负载分布
+    WorkloadDistribution WD_UCO;        // carry-out工作负载分布
+};
+
+// 任务的工作负载分布缓存, 由DAGTask::getArtifactCache获取, 在任务副本之间共享
+// 同一任务的副本可能被并发分析, 读写artifacts时需持有mtx
+struct workloadArtifactCache{
+    std::mutex mtx;
+    std::shared_ptr<const workloadArtifacts> artifacts;    // 尚未计算时为空
+};
+
+}
+
+#endif /* WORKLOADARTIFACTS_H */
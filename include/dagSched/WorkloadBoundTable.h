@@ -0,0 +1,52 @@
+#ifndef WORKLOADBOUNDTABLE_H
+#define WORKLOADBOUNDTABLE_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "dagSched/Taskset.h"
+
+namespace dagSched{
+
+// 与std::fmod(x, T)结果相同的余数, 但不调用libm, 可以被向量化
+// 商在double中计算并截断, 对float操作数不会因舍入跨过整数; T * q在商小于2^29时在double中精确,
+// 差值也是精确的, 而fmod的结果总能用float精确表示, 因此转换回float时不再舍入
+inline float remainderOf(const float x, const float T){
+    const double q = std::trunc((double) x / T);
+    return (float) ((double) x - (double) T * q);
+}
+
+// Melani等人的工作负载上界: 响应时间为R的任务在长度为t的区间内的最大工作负载
+// workloadUpperBound与WorkloadBoundTable共用此函数, 保证两者的浮点结果一致
+inline float workloadBound(const float wcw, const float T, const float R, const float t, const int m){
+    float ci_b = std::floor((t + R - wcw / m ) / T ) * wcw;
+    float co = std::min(wcw, m * remainderOf(t + R - wcw / m ,T) );
+
+    return ci_b + co;
+}
+
+// 全局FTP不动点迭代中高优先级任务的干扰参数表
+// 每个任务的wcw、周期和响应时间以结构数组的形式存放, 一次计算前n个任务的工作负载上界,
+// 循环中没有依赖, 只读连续数组。累加由调用者按原来的顺序进行, 因此结果与逐个调用
+// workloadUpperBound完全相同。任务的响应时间改变时需调用setResponse。
+class WorkloadBoundTable{
+
+    std::vector<float> wcw;     // 最坏情况工作负载
+    std::vector<float> T;       // 周期
+    std::vector<float> R;       // 响应时间
+    std::vector<float> bound;   // 最近一次计算的上界
+
+    public:
+
+    WorkloadBoundTable(){};
+    explicit WorkloadBoundTable(const Taskset& taskset);
+
+    void setResponse(const int x, const Time_t R_x){ R[x] = R_x; }
+
+    // 计算前n个任务在长度为t的区间内的工作负载上界, 返回的数组在下一次调用前有效
+    const float* bounds(const int n, const float t, const int m);
+};
+
+}
+
+#endif /* WORKLOADBOUNDTABLE_H */
@@ -0,0 +1,36 @@
+#ifndef WORKLOADDISTRIBUTION_H
+#define WORKLOADDISTRIBUTION_H
+
+#include <vector>
+#include <utility>
+
+namespace dagSched{
+
+// 工作负载分布(WD_UCI / WD_UCO)的累积函数
+// 分布是一串[宽度, 高度]区间, 区间依次排列后, workload(x)给出前x个时间单位内的工作负载,
+// 即各区间高度乘以其落在[0, x]内的长度之和。构建时计算断点(区间宽度的前缀和)和断点处的
+// 累积工作负载, 之后每次求值是一次二分查找, 代替原来对每个区间重新累加宽度的O(n^2)循环。
+// carry-in从分布的最后一个区间开始排列(fromEnd = true), carry-out从第一个区间开始。
+class WorkloadDistribution{
+
+    std::vector<std::pair<float, float>> WD;    // 原始分布, 按原来的顺序
+    std::vector<float> breaks;      // 排列后的断点, breaks[0] = 0, 大小为区间数加1
+    std::vector<float> cumul;       // 断点处的累积工作负载
+    std::vector<float> heights;     // 排列后第k个区间的高度
+
+    public:
+
+    WorkloadDistribution(){};
+    WorkloadDistribution(const std::vector<std::pair<float, float>>& WD, const bool fromEnd);
+
+    int size() const {return WD.size();}
+    float width(const int i) const {return WD[i].first;}
+    float height(const int i) const {return WD[i].second;}
+
+    // 从排列起点开始长度为x的区间内的工作负载, x <= 0时为0
+    float workload(const float x) const;
+};
+
+}
+
+#endif /* WORKLOADDISTRIBUTION_H */
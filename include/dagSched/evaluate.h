@@ -1,15 +1,175 @@
 #ifndef EVALUATE_H
 #define EVALUATE_H
 
+#include <cstdio>
+#include <mutex>
+#include <filesystem>
+#include <oneapi/tbb/parallel_pipeline.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
+#include <oneapi/tbb/info.h>
+
 #include "dagSched/utils.h"
 #include "dagSched/GeneratorParams.h"
 #include "dagSched/Taskset.h"
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisRegistry.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/PerfCounters.h"
+#include "dagSched/AllocAccounting.h"
+#include "dagSched/ResultSink.h"
+#include "dagSched/EvalCheckpoint.h"
 #include "dagSched/plot_utils.h"
 
 namespace dagSched{
 
-void evaluate(const std::string& genparams_path, const std::string& output_fig_path, const bool show_plots){
+// a taskset of the evaluation, with the parameters of the sweep point it belongs to
+struct tasksetJob{
+    int i           = 0;    // index of the taskset
+    int test_idx    = 0;    // index of the point of the sweep the taskset belongs to
+    float x         = 0;    // value of the sweep point
+    int m           = 0;    // number of cores
+    int n_tasks     = 0;    // number of tasks to generate
+    float U         = 0;    // utilization to generate
+    Taskset task_set;
+    std::vector<resultRow> rows;    // results of the analyses on the taskset
+};
+
+// each taskset draws from its own stream, keyed by (seed, sweep point, taskset index),
+// so it does not depend on which worker generates it or on the tasksets generated before
+void generateTaskset(tasksetJob& job, const GeneratorParams& gp){
+    RandomStream rng(gp.seed, job.test_idx, job.i);
+    Taskset& task_set = job.task_set;
+    task_set.generate_taskset_Melani(job.n_tasks, job.U, job.m, gp, rng);
+
+    int max_v_size = 0;
+    for(int ii=0; ii<task_set.tasks.size(); ++ii)
+        if(task_set.tasks[ii].getVertices().size() > max_v_size)
+            max_v_size = task_set.tasks[ii].getVertices().size();
+
+    std::stringstream info;
+    info<<"taskset: "<<job.i<<" U: "<<job.U<<" ntasks: "<<task_set.tasks.size()<<" max|V|: "<<max_v_size<<" m:"<<job.m<< " test_idx: "<<job.test_idx<<"\n";
+    std::cout<<info.str()<<std::flush;
+
+    // for(int x=0; x<task_set.tasks.size();++x){
+    //     task_set.tasks[x].saveAsDot("test"+std::to_string(x)+".dot");
+    //     std::string dot_command = "dot -Tpng test"+std::to_string(x)+".dot > test"+std::to_string(job.i)+".png";
+    //     system(dot_command.c_str());
+    // }
+}
+
+// run the planned analyses on a taskset: the ones that can run concurrently are dispatched
+// together, the others run one at a time afterwards. Each analysis writes its own row, so the
+// rows are in plan order whatever the interleaving.
+// With a perf aggregator, the counters of the thread running each analysis are added to it.
+// When the library is built with allocation accounting, each row also records the allocations
+// made by its analysis.
+void analyseTaskset(tasksetJob& job, const GeneratorParams& gp, const std::vector<const AnalysisInfo*>& plan, PerfAggregator* perf = nullptr){
+    Taskset& task_set = job.task_set;
+
+    bool partitioned = false;
+    for(const auto a: plan)
+        partitioned = partitioned || a->needsPartitioning;
+    if(partitioned)
+        WorstFitProcessorsAssignment(task_set, job.m);
+
+    // fill the lazily computed caches now, so that the analyses only read the shared tasks
+    for(auto &t:task_set.tasks){
+        t.computeMetrics();
+        t.getCSR();
+        t.getReachability();
+    }
+
+    job.rows.resize(plan.size());
+    // each analysis gets its own budget, installed on the thread that runs it.
+    // The analysis is isolated: a thread waiting inside it (e.g. for its own parallel loops) does
+    // not pick up the analysis of another taskset, whose time, counters and allocations would
+    // otherwise be charged to this row
+    auto run = [&](const int k){
+        tbb::this_task_arena::isolate([&]{
+            AnalysisBudget budget(gp.timeout, gp.maxIterations);
+            BudgetScope scope(budget);
+            SimpleTimer timer;
+            timer.tic();
+            resultRow& r = job.rows[k];
+            bool sched;
+            allocStats alloc;
+            {
+                PerfScope perf_scope(perf, plan[k]->name);
+                AllocScope alloc_scope(alloc);
+                sched = plan[k]->run(task_set, job.m, gp);
+            }
+            r.time = timer.toc();
+            r.allocations = alloc.allocations;
+            r.bytes = alloc.bytes;
+            r.peakBytes = alloc.peakBytes;
+            r.sched = budget.isExhausted() ? Verdict_t::TIMED_OUT : (sched ? Verdict_t::SCHEDULABLE : Verdict_t::NOT_SCHEDULABLE);
+            r.taskset = job.i;
+            r.point = job.test_idx;
+            r.x = job.x;
+            r.m = job.m;
+            r.n_tasks = job.n_tasks;
+            r.U = job.U;
+            r.test = plan[k]->name;
+        });
+    };
+
+    std::vector<int> concurrent, serial;
+    for(int k=0; k<plan.size(); ++k)
+        (plan[k]->parallelSafe ? concurrent : serial).push_back(k);
+
+    tbb::parallel_for(size_t(0), concurrent.size(), [&](size_t k){ run(concurrent[k]); });
+    for(const int k: serial)
+        run(k);
+
+    for(auto &t:task_set.tasks)
+        t.destroyVerices();
+}
+
+std::string xAxisLabel(const GenerationType_t gt){
+    switch (gt){
+    case GenerationType_t::VARYING_M:
+        return "Number of cores";
+    case GenerationType_t::VARYING_N:
+        return "Number of tasks";
+    case GenerationType_t::VARYING_U:
+        return "Taskset utilization";
+    }
+    return "";
+}
+
+// plot the results saved by a previous evaluation, without running the analyses again
+void plotSavedResults(const std::string& results_path, const std::string& output_fig_path, const bool show_plots){
+    evalResults res;
+    if(!readResults(results_path, res))
+        FatalError("Can't read the results in " + results_path);
+
+    for(const auto& to: res.timedOut){
+        std::cout<<to.first<<" timed out on";
+        for(const int n: to.second)
+            std::cout<<" "<<n;
+        std::cout<<" tasksets"<<std::endl;
+    }
+
+    for(const auto& p: res.peakBytes)
+        std::cout<<p.first<<" peak memory: "<<p.second<<" bytes"<<std::endl;
+
+    plotResults(res.sched, res.x, res.xLabel, "Taskset scheduled", output_fig_path, show_plots);
+    plotTimes(res.times, output_fig_path, show_plots);
+}
+
+// The sweep parameters are assigned serially and in taskset order; generation and analyses of
+// different tasksets run in parallel on the TBB work-stealing scheduler. Every analysis of every
+// taskset is streamed as a row to <output_fig_path>.csv, and the plots are drawn from that file
+// once all the tasksets have been analysed, so nothing is kept in memory during the sweep.
+// The analyses run on each taskset are planned once from the AnalysisRegistry, among those
+// supporting the generated model, restricted by gp.analyses and gp.maxCost.
+// With gp.perfCounters, cycles, instructions, cache and branch misses and page faults of every
+// analysis are aggregated per analysis, printed at the end and saved in <output_fig_path>.perf.csv
+// (on a resumed run they cover only the tasksets analysed after the checkpoint).
+// Every gp.saveRate tasksets a checkpoint is saved in <output_fig_path>.ckpt: with resume set,
+// a previous interrupted run is continued from its last checkpoint, skipping the completed tasksets.
+void evaluate(const std::string& genparams_path, const std::string& output_fig_path, const bool show_plots, const bool resume = false){
     GeneratorParams gp;
     gp.readFromYaml(genparams_path);
     gp.configureParams(gp.gType);
@@ -26,327 +186,139 @@ void evaluate(const std::string& genparams_path, const std::string& output_fig_p
     if(gp.gType == GenerationType_t::VARYING_N)
         n_tasks = gp.nMin - 1;
 
-    std::map<std::string,std::vector<float>> sched_res;
-    std::map<std::string,std::vector<double>> time_res;
-    std::vector<float> x;
-
+    float x_curr = 0;
     int test_idx = -1;
-    SimpleTimer timer;
 
-    int min_V_all  = 100;
-    int max_V_all  = 0;
+    const std::string results_path = output_fig_path + ".csv";
+    const std::string checkpoint_path = output_fig_path + ".ckpt";
+
+    EvalCheckpoint ckpt;
+    bool resuming = false;
+    if(resume && ckpt.load(checkpoint_path)){
+        if( ckpt.configHash != hashFileContent(genparams_path) || ckpt.seed != gp.seed ||
+            ckpt.nTasksets != gp.nTasksets)
+            FatalError("The checkpoint " + checkpoint_path + " belongs to a different configuration");
+        if(!std::filesystem::exists(results_path))
+            FatalError("Can't resume without the results in " + results_path);
+
+        // drop the rows written after the checkpoint, their tasksets are analysed again
+        std::filesystem::resize_file(results_path, ckpt.resultsSize);
+        resuming = true;
+        std::cout<<"resuming from "<<checkpoint_path<<": "<<ckpt.progress.nDone()<<" tasksets already analysed"<<std::endl;
+    }
+    else{
+        ckpt.configHash = hashFileContent(genparams_path);
+        ckpt.seed = gp.seed;
+        ckpt.nTasksets = gp.nTasksets;
+    }
 
-    for(int i=0; i<gp.nTasksets; ++i){
-        if(gp.gType == GenerationType_t::VARYING_U && i % gp.tasksetPerVarFactor == 0){
-            U_curr += gp.stepU;
-            x.push_back(U_curr);
-            test_idx++;
-        }
-        else if(gp.gType == GenerationType_t::VARYING_N && i % gp.tasksetPerVarFactor == 0){
-            n_tasks += gp.stepN;
-            x.push_back(n_tasks);
-            test_idx++;
-        }
-        else if(gp.gType == GenerationType_t::VARYING_M && i % gp.tasksetPerVarFactor == 0){
-            m += gp.stepM;
-            x.push_back(m);
-            test_idx++;
-        }
-        
-        Taskset task_set;
-        task_set.generate_taskset_Melani(n_tasks, U_curr, m, gp);
-
-        int max_v_size = 0;
-        for(int ii=0; ii<task_set.tasks.size(); ++ii)
-            if(task_set.tasks[ii].getVertices().size() > max_v_size)
-                max_v_size = task_set.tasks[ii].getVertices().size();
-
-        if (max_v_size > max_V_all) max_V_all = max_v_size;
-        if (max_v_size < min_V_all) min_V_all = max_v_size;
-
-        std::cout<<"taskset: "<<i<<" U: "<<U_curr<<" ntasks: "<<task_set.tasks.size()<<" max|V|: "<<max_V_all<<" min|V|: "<<min_V_all<<" m:"<<m<< " test_idx: "<<test_idx<<std::endl;
-
-        // for(int x=0; x<task_set.tasks.size();++x){
-        //     task_set.tasks[x].saveAsDot("test"+std::to_string(x)+".dot");
-        //     std::string dot_command = "dot -Tpng test"+std::to_string(x)+".dot > test"+std::to_string(i)+".png";
-        //     system(dot_command.c_str());
-        // }
-
-        if(gp.sType == SchedulingType_t::GLOBAL){
-            switch (gp.dtype){
-            case DeadlinesType_t::CONSTRAINED: case DeadlinesType_t::IMPLICIT:
-                if(gp.aType == AlgorithmType_t::EDF && gp.DAGType == DAGType_t::DAG ){
-                    if(i % gp.tasksetPerVarFactor == 0){
-                        sched_res["Qamhieh2013"].push_back(0);
-                        // sched_res["Baruah2014"].push_back(0);
-                        sched_res["Melani2015"].push_back(0);
-                    }
-
-                    timer.tic();
-                    sched_res["Qamhieh2013"][test_idx] += GP_FP_EDF_Qamhieh2013_C(task_set, m);
-                    time_res["Qamhieh2013"].push_back(timer.toc());
-
-                    // timer.tic();
-                    // sched_res["Baruah2014"][test_idx] += GP_FP_EDF_Baruah2014_C(task_set, m);
-                    // time_res["Baruah2014"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Melani2015"][test_idx] += GP_FP_EDF_Melani2015_C(task_set, m);
-                    time_res["Melani2015"].push_back(timer.toc());
-                    
-                    if(gp.wType == workloadType_t::SINGLE_DAG){
-                        if(i % gp.tasksetPerVarFactor == 0)
-                            sched_res["Baruah2012"].push_back(0);
-                        
-                        timer.tic();
-                        sched_res["Baruah2012"][test_idx] += GP_FP_EDF_Baruah2012_C(task_set.tasks[0], m);
-                        time_res["Baruah2012"].push_back(timer.toc());
-                    }
-
-                    if(gp.dtype != DeadlinesType_t::CONSTRAINED){
-                        if(i % gp.tasksetPerVarFactor == 0)
-                            sched_res["Li2013"].push_back(0);
-                        
-                        timer.tic();
-                        sched_res["Li2013"][test_idx] += GP_FP_EDF_Li2013_I(task_set, m);
-                        time_res["Li2013"].push_back(timer.toc());
-                    }
-                }
-                else if(gp.aType == AlgorithmType_t::FTP && gp.DAGType ==DAGType_t::DAG){
-                    if(i % gp.tasksetPerVarFactor == 0){
-                        sched_res["Bonifaci2013"].push_back(0);
-                        sched_res["Melani2015"].push_back(0);
-                        sched_res["Serrano2016"].push_back(0);
-                        sched_res["Pathan2017"].push_back(0);
-                        sched_res["Fonseca2017"].push_back(0);
-                        sched_res["Fonseca2019"].push_back(0);
-                        sched_res["Nasri2019"].push_back(0);
-                        sched_res["He2019"].push_back(0);
-                    }
-
-                    timer.tic();
-                    sched_res["Bonifaci2013"][test_idx] +=  GP_FP_DM_Bonifaci2013_C(task_set, m);
-                    time_res["Bon2013"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Melani2015"][test_idx] +=  GP_FP_FTP_Melani2015_C(task_set, m);
-                    time_res["Mel2015"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Serrano2016"][test_idx] += GP_LP_FTP_Serrano16_C(task_set, m);
-                    time_res["Ser2016"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Pathan2017"][test_idx] +=  GP_FP_DM_Pathan2017_C(task_set, m);
-                    time_res["Pat2017"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Fonseca2017"][test_idx] +=  GP_FP_FTP_Fonseca2017_C(task_set, m);
-                    time_res["Fon2017"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Fonseca2019"][test_idx] +=  GP_FP_FTP_Fonseca2019(task_set, m);
-                    time_res["Fon2019"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Nasri2019"][test_idx] +=  G_LP_FTP_Nasri2019_C(task_set, m);
-                    time_res["Nas2019"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["He2019"][test_idx] +=  GP_FP_FTP_He2019_C(task_set, m);
-                    time_res["He2019"].push_back(timer.toc());
-                }
-
-                else if(gp.aType == AlgorithmType_t::EDF && gp.DAGType ==DAGType_t::CDAG ){
-                    if(i % gp.tasksetPerVarFactor == 0)
-                        sched_res["Melani2015"].push_back(0);
-
-                    timer.tic();
-                    sched_res["Melani2015"][test_idx] +=  GP_FP_EDF_Melani2015_C(task_set, m);
-                    time_res["Melani2015"].push_back(timer.toc());
-                }
-                else if(gp.aType == AlgorithmType_t::FTP && gp.DAGType ==DAGType_t::CDAG){
-                    if(i % gp.tasksetPerVarFactor == 0){
-                        sched_res["Melani2015"].push_back(0);
-                        sched_res["Pathan2017"].push_back(0);
-                    }
-
-                    timer.tic();
-                    sched_res["Melani2015"][test_idx] +=  GP_FP_FTP_Melani2015_C(task_set, m);
-                    time_res["Melani2015"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Pathan2017"][test_idx] +=  GP_FP_DM_Pathan2017_C(task_set, m);
-                    time_res["Pathan2017"].push_back(timer.toc());
-                }
-
-                else if(gp.aType == AlgorithmType_t::FTP && gp.DAGType ==DAGType_t::TDAG && gp.wType == workloadType_t::SINGLE_DAG){
-                    if(i % gp.tasksetPerVarFactor == 0)
-                        sched_res["Han2019"].push_back(0);
-
-                    timer.tic();
-                    sched_res["Han2019"][test_idx] +=  GP_FP_Han2019_C_1(task_set.tasks[0], gp.typedProc);
-                    time_res["Han2019"].push_back(timer.toc());
-                }
-
-                
-                break;
-            case DeadlinesType_t::ARBITRARY:
-                if(gp.aType == AlgorithmType_t::EDF && gp.DAGType ==DAGType_t::DAG ){
-                    if(i % gp.tasksetPerVarFactor == 0)
-                        sched_res["Bonifaci2013"].push_back(0);
-                    
-                    timer.tic();
-                    sched_res["Bonifaci2013"][test_idx] += GP_FP_EDF_Bonifaci2013_A(task_set, m);
-                    time_res["Bonifaci2013"].push_back(timer.toc());
-
-                    if(gp.wType == workloadType_t::SINGLE_DAG){
-                        if(i % gp.tasksetPerVarFactor == 0)
-                            sched_res["Baruah2012"].push_back(0);
-                        
-                        timer.tic();
-                        sched_res["Baruah2012"][test_idx] += GP_FP_EDF_Baruah2012_A(task_set.tasks[0], m);
-                        time_res["Baruah2012"].push_back(timer.toc());
-                    }
-                }
-                else if(gp.aType == AlgorithmType_t::FTP && gp.DAGType ==DAGType_t::DAG ){
-                    if(i % gp.tasksetPerVarFactor == 0){
-                        sched_res["Bonifaci2013"].push_back(0);
-                        sched_res["Fonseca2019"].push_back(0);
-                    }
-
-                    timer.tic();
-                    sched_res["Bonifaci2013"][test_idx] += GP_FP_DM_Bonifaci2013_A(task_set, m);
-                    time_res["Bonifaci2013"].push_back(timer.toc());
-
-                    timer.tic();
-                    sched_res["Fonseca2019"][test_idx] += GP_FP_FTP_Fonseca2019(task_set, m, false);
-                    time_res["Fonseca2019"].push_back(timer.toc());
-
-                    if(gp.wType == workloadType_t::SINGLE_DAG){
-                        if(i % gp.tasksetPerVarFactor == 0)
-                            sched_res["Graham1969"].push_back(0);
-
-                        timer.tic();
-                        sched_res["Graham1969"][test_idx] += Graham1969(task_set.tasks[0], m);
-                        time_res["Graham1969"].push_back(timer.toc());
-                    }
-                }
-                break;
+    const std::vector<const AnalysisInfo*> plan = AnalysisRegistry::instance().buildPlan(gp);
+    if(plan.empty())
+        FatalError("No selected analysis supports the configuration in " + genparams_path);
+    std::cout<<"analyses:";
+    for(const auto a: plan)
+        std::cout<<" "<<a->name;
+    std::cout<<std::endl;
+
+    ResultSink sink(results_path, xAxisLabel(gp.gType), resuming);
+
+    PerfAggregator perf;
+    if(gp.perfCounters && !PerfCounters::threadCounters().available())
+        std::cout<<"performance counters not available, check /proc/sys/kernel/perf_event_paranoid"<<std::endl;
+
+    int i = 0;
+    auto next_taskset = [&](tbb::flow_control& fc) -> tasksetJob* {
+        while(i < gp.nTasksets){
+            if(gp.gType == GenerationType_t::VARYING_U && i % gp.tasksetPerVarFactor == 0){
+                U_curr += gp.stepU;
+                x_curr = U_curr;
+                test_idx++;
             }
-        }
-        else if(gp.sType == SchedulingType_t::PARTITIONED){
-            
-            if(gp.aType == AlgorithmType_t::FTP && gp.DAGType == DAGType_t::DAG && gp.dtype != DeadlinesType_t::ARBITRARY){
-                 if(i % gp.tasksetPerVarFactor == 0){
-                    sched_res["Fonseca2016"].push_back(0);
-                    sched_res["Casini2018"].push_back(0);
-                    // sched_res["Casini2018_W"].push_back(0);
-                    // sched_res["Casini2018_B"].push_back(0);
-                    // sched_res["Casini2018_F"].push_back(0);
-                    // sched_res["Casini2018_P"].push_back(0);
-                    #ifdef ZAHAF2019
-                    sched_res["Zahaf2019"].push_back(0);
-                    #endif
-                 }
-                
-                WorstFitProcessorsAssignment(task_set, m);
-
-                timer.tic();
-                sched_res["Fonseca2016"][test_idx] += P_FP_FTP_Fonseca2016_C(task_set, m);
-                time_res["Fonseca2016"].push_back(timer.toc());
-
-                timer.tic();
-                sched_res["Casini2018"][test_idx] += P_LP_FTP_Casini2018_C(task_set, m);
-                time_res["Casini2018"].push_back(timer.toc());
-                
-                // timer.tic();
-                // int worst = P_LP_FTP_Casini2018_C_withAssignment(task_set, m, PartitioningCoresOrder_t::WORST_FIT);
-                // sched_res["Casini2018_W"][test_idx] += worst;
-                // time_res["Casini2018_W"].push_back(timer.toc());
-
-                // timer.tic();
-                // int best = P_LP_FTP_Casini2018_C_withAssignment(task_set, m, PartitioningCoresOrder_t::BEST_FIT);
-                // sched_res["Casini2018_B"][test_idx] += best;
-                // time_res["Casini2018_B"].push_back(timer.toc());
-
-                // timer.tic();
-                // int first = P_LP_FTP_Casini2018_C_withAssignment(task_set, m, PartitioningCoresOrder_t::FIRST_FIT);
-                // sched_res["Casini2018_F"][test_idx] += first;
-                // time_res["Casini2018_F"].push_back(timer.toc());
-
-                // std::cout<<"PARTITIONED: "<<(first || best || worst)<<std::endl;
-                // sched_res["Casini2018_P"][test_idx] += (int) (first || best || worst);
-                // time_res["Casini2018_P"].push_back(time_res["Casini2018_F"].back() + time_res["Casini2018_B"].back() + time_res["Casini2018_W"].back());
-
-                #ifdef ZAHAF2019
-                timer.tic();
-                sched_res["Zahaf2019"][test_idx] += P_LP_EDF_Zahaf2019_C(task_set, m);
-                time_res["Zahaf2019"].push_back(timer.toc());
-                #endif
+            else if(gp.gType == GenerationType_t::VARYING_N && i % gp.tasksetPerVarFactor == 0){
+                n_tasks += gp.stepN;
+                x_curr = n_tasks;
+                test_idx++;
+            }
+            else if(gp.gType == GenerationType_t::VARYING_M && i % gp.tasksetPerVarFactor == 0){
+                m += gp.stepM;
+                x_curr = m;
+                test_idx++;
             }
-        }
 
-        else if(gp.sType == SchedulingType_t::SOTA){
-            if(gp.aType == AlgorithmType_t::FTP && gp.DAGType == DAGType_t::DAG && gp.dtype != DeadlinesType_t::ARBITRARY){
-                if(i % gp.tasksetPerVarFactor == 0){
-                    sched_res["Melani2015"].push_back(0);
-                    sched_res["Fonseca2016"].push_back(0);
-                    // sched_res["Serrano2016"].push_back(0);
-                    sched_res["Casini2018"].push_back(0);
-                    sched_res["Fonseca2019"].push_back(0);
-                    sched_res["Nasri2019"].push_back(0);
-                    
-                }
+            // the sweep parameters still advance over the completed tasksets
+            if(ckpt.progress.isDone(i)){
+                ++i;
+                continue;
+            }
 
-                WorstFitProcessorsAssignment(task_set, m);
+            tasksetJob* job = new tasksetJob;
+            job->i = i;
+            job->test_idx = test_idx;
+            job->x = x_curr;
+            job->m = m;
+            job->n_tasks = n_tasks;
+            job->U = U_curr;
 
-                timer.tic();
-                sched_res["Melani2015"][test_idx] +=  GP_FP_FTP_Melani2015_C(task_set, m);
-                time_res["Mel2015"].push_back(timer.toc());
+            ++i;
+            return job;
+        }
 
-                // timer.tic();
-                // sched_res["Serrano2016"][test_idx] += GP_LP_FTP_Serrano16_C(task_set, m);
-                // time_res["Serrano2016"].push_back(timer.toc());
+        fc.stop();
+        return nullptr;
+    };
+
+    // the rows of a taskset and its completion enter the checkpoint together: under the lock only
+    // a snapshot is taken, the results are flushed and the checkpoint written after releasing it,
+    // so the other workers do not wait for the disk. One checkpoint is saved at a time.
+    std::mutex progress_mtx;
+    int since_checkpoint = 0;
+    bool saving = false;
+    auto complete = [&](const tasksetJob& job){
+        EvalCheckpoint snapshot;
+        {
+            std::lock_guard<std::mutex> lock(progress_mtx);
+            sink.write(job.rows);
+            ckpt.progress.markDone(job.i);
+
+            if(gp.saveRate <= 0 || ++since_checkpoint < gp.saveRate || saving)
+                return;
+            since_checkpoint = 0;
+            saving = true;
+            snapshot = ckpt;
+            snapshot.resultsSize = sink.size();
+        }
 
-                timer.tic();
-                sched_res["Fonseca2016"][test_idx] += P_FP_FTP_Fonseca2016_C(task_set, m);
-                time_res["Fonseca2016"].push_back(timer.toc());
+        sink.flush(snapshot.resultsSize);
+        snapshot.save(checkpoint_path);
 
-                timer.tic();
-                sched_res["Casini2018"][test_idx] += P_LP_FTP_Casini2018_C(task_set, m);
-                time_res["Casini2018"].push_back(timer.toc());
+        std::lock_guard<std::mutex> lock(progress_mtx);
+        saving = false;
+    };
 
-                timer.tic();
-                sched_res["Fonseca2019"][test_idx] +=  GP_FP_FTP_Fonseca2019(task_set, m);
-                time_res["Fon2019"].push_back(timer.toc());
+    auto analyse = [&](tasksetJob* job){
+        generateTaskset(*job, gp);
+        analyseTaskset(*job, gp, plan, gp.perfCounters ? &perf : nullptr);
+        complete(*job);
+        delete job;
+    };
 
-                timer.tic();
-                sched_res["Nasri2019"][test_idx] +=  G_LP_FTP_Nasri2019_C(task_set, m);
-                time_res["Nasri2019"].push_back(timer.toc());
+    const size_t max_live_tasksets = 2 * tbb::info::default_concurrency();
+    tbb::parallel_pipeline(max_live_tasksets,
+        tbb::make_filter<void, tasksetJob*>(tbb::filter_mode::serial_in_order, next_taskset) &
+        tbb::make_filter<tasksetJob*, void>(tbb::filter_mode::parallel, analyse));
 
-            }
-        }
+    sink.close();
+    std::remove(checkpoint_path.c_str());
 
-        for(auto &t:task_set.tasks)
-            t.destroyVerices();
+    if(gp.perfCounters){
+        perf.print(std::cout);
+        perf.save(output_fig_path + ".perf.csv");
     }
 
-
-    std::string x_axis_label;
-    if(gp.gType == GenerationType_t::VARYING_M)
-        x_axis_label = "Number of cores";
-    else if(gp.gType == GenerationType_t::VARYING_M)
-        x_axis_label = "Number of tasks";
-    else if(gp.gType == GenerationType_t::VARYING_U)
-        x_axis_label = "Taskset utilization";
-
-    plotResults(sched_res, x, x_axis_label, "Taskset scheduled", output_fig_path, show_plots);
-    plotTimes(time_res, output_fig_path, show_plots);
-
+    plotSavedResults(results_path, output_fig_path, show_plots);
 }
 
 }
 
 
-#endif /* EVALUATE_H */
\ No newline at end of file
+#endif /* EVALUATE_H */
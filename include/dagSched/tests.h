@@ -4,6 +4,8 @@
 #include <iostream>
 #include "dagSched/DAGTask.h"
 #include "dagSched/Taskset.h"
+#include "dagSched/WorkloadDistribution.h"
+#include "dagSched/WorkloadArtifacts.h"
 
 namespace dagSched{
 
@@ -43,8 +45,11 @@ bool GP_FP_DM_Pathan2017_C(Taskset taskset, const int m);
 
 std::vector<std::pair<float, float>> computeWorkloadDistributionCO(const DAGTask& t, const int task_idx);
 std::vector<std::pair<float, float>> computeWorkloadDistributionCI(const DAGTask& task);
+std::shared_ptr<const workloadArtifacts> getWorkloadArtifacts(const DAGTask& task, const int task_idx);
 float computeCarryOutUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCO_y);
 float computeCarryInUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCI_y);
+float computeCarryOutUpperBound(const DAGTask& task, const int interval, const WorkloadDistribution& WD_UCO_y);
+float computeCarryInUpperBound(const DAGTask& task, const int interval, const WorkloadDistribution& WD_UCI_y);
 bool GP_FP_FTP_Fonseca2017_C(Taskset taskset, const int m); 
 
 bool GP_FP_FTP_Fonseca2019(Taskset taskset, const int m, bool constrained_deadlines = true);
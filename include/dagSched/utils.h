@@ -9,6 +9,9 @@
 #include<utility>
 #include<algorithm>
 #include<iomanip>
+#include<limits>
+#include<cstdint>
+#include<type_traits>
 
 // 定义可复现模式标志
 #define REPRODUCIBLE 1
@@ -118,15 +121,43 @@ void printPairVector(const std::vector<std::pair<T1, T2>>& v, const std::string&
     std::cout<<std::endl;
 }
 
-// 浮点数相等比较
+// 时间量(WCET、周期、截止时间、响应时间等)的表示类型
+// 默认为float; 以INTEGER_TIME编译时为64位整数时钟周期, 此时不动点迭代可精确收敛
+#ifdef INTEGER_TIME
+typedef int64_t Time_t;
+#else
+typedef float Time_t;
+#endif
+
+// 相等比较: 整数精确比较, 浮点数按机器精度比较
 template<typename T>
 bool areEqual(const T a, const T b){
-    return std::fabs(a - b) < std::numeric_limits<T>::epsilon();
+    if constexpr (std::is_integral<T>::value)
+        return a == b;
+    else
+        return std::fabs(a - b) < std::numeric_limits<T>::epsilon();
+}
+
+// 将计算得到的时间值转换为Time_t, 浮点时间直接转换
+// 整数时间时, toTime向上取整, 用于WCET与响应时间等上界;
+// toTimeDown向下取整, 用于周期与截止时间, 两者都使分析结果保持安全(悲观)
+template<typename T>
+Time_t toTime(const T v){
+    if constexpr (std::is_integral<Time_t>::value && std::is_floating_point<T>::value)
+        return (Time_t) std::ceil(v);
+    else
+        return (Time_t) v;
+}
+
+template<typename T>
+Time_t toTimeDown(const T v){
+    if constexpr (std::is_integral<Time_t>::value && std::is_floating_point<T>::value)
+        return (Time_t) std::floor(v);
+    else
+        return (Time_t) v;
 }
 
 // 函数声明
-int intRandMaxMin(const int v_min, const int v_max);
-float floatRandMaxMin(const float v_min, const float v_max);
 void removePathAndExtension(const std::string &full_string, std::string &name);
 
 // DOT文件行类型枚举
@@ -140,9 +171,9 @@ struct dot_info{
     int id          = -1;  // 节点ID
     int id_from     = -1;  // 起始节点ID(边)
     int id_to       = -1;  // 目标节点ID(边)
-    float wcet      = 0;   // 最坏情况执行时间
-    float period    = 0;   // 周期
-    float deadline  = 0;   // 截止时间
+    Time_t wcet     = 0;   // 最坏情况执行时间
+    Time_t period   = 0;   // 周期
+    Time_t deadline = 0;   // 截止时间
 };
 
 // 在逗号处分割字符串
@@ -0,0 +1,89 @@
+#include "dagSched/Admission.h"
+#include "dagSched/AnalysisRegistry.h"
+#include "dagSched/tests.h"
+#include "dagSched/utils.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace dagSched{
+
+admissionResult cascadeAdmission(const Taskset& taskset, const int m, const GeneratorParams& gp){
+    // 单个DAG的分析只读取第一个任务, 用于多任务的任务集会只凭第一个任务接受整个任务集
+    if(gp.wType == workloadType_t::SINGLE_DAG && taskset.tasks.size() != 1)
+        FatalError("Single DAG admission requires a taskset with exactly one task");
+
+    admissionResult res;
+    SimpleTimer total_timer, timer;
+    total_timer.tic();
+
+    auto addStep = [&](const std::string& test, const int verdict, const double time){
+        admissionStep step;
+        step.test = test;
+        step.verdict = verdict;
+        step.time = time;
+        res.steps.push_back(step);
+    };
+
+    // 必要条件
+    timer.tic();
+    bool length_ok = true;
+    float U = 0;
+    for(const auto& t: taskset.tasks){
+        if(t.getLength() > t.getDeadline())
+            length_ok = false;
+        U += t.getUtilization();
+    }
+    const double check_time = timer.toc();
+
+    if(!length_ok || U > m){
+        res.decidedBy = !length_ok ? "L > D" : "U > m";
+        res.decidingTime = check_time;
+        addStep(res.decidedBy, Verdict_t::NOT_SCHEDULABLE, check_time);
+        res.totalTime = total_timer.toc();
+        return res;
+    }
+
+    std::vector<const AnalysisInfo*> plan = AnalysisRegistry::instance().buildPlan(gp);
+    std::stable_sort(plan.begin(), plan.end(),
+        [](const AnalysisInfo* a, const AnalysisInfo* b){ return a->cost < b->cost; });
+
+    // 分区在顶点的副本上进行, 不修改输入的任务集
+    std::unique_ptr<Taskset> partitioned;
+    for(const auto a: plan){
+        const Taskset* to_analyse = &taskset;
+        if(a->needsPartitioning){
+            if(!partitioned){
+                partitioned.reset(new Taskset(taskset));
+                for(auto& t: partitioned->tasks){
+                    std::vector<SubTask*> V = t.getVertices();
+                    t.cloneVertices(V);
+                }
+                WorstFitProcessorsAssignment(*partitioned, m);
+            }
+            to_analyse = partitioned.get();
+        }
+
+        AnalysisBudget budget(gp.timeout, gp.maxIterations);
+        BudgetScope scope(budget);
+        timer.tic();
+        const bool sched = a->run(*to_analyse, m, gp);
+        const double time = timer.toc();
+
+        const int verdict = budget.isExhausted() ? Verdict_t::TIMED_OUT : (sched ? Verdict_t::SCHEDULABLE : Verdict_t::NOT_SCHEDULABLE);
+        addStep(a->name, verdict, time);
+
+        // 充分条件的否定不能决定结果, 只有接受时停止
+        if(verdict == Verdict_t::SCHEDULABLE){
+            res.admitted = true;
+            res.decidedBy = a->name;
+            res.decidingTime = time;
+            break;
+        }
+    }
+
+    res.totalTime = total_timer.toc();
+    return res;
+}
+
+}
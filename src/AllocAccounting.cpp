@@ -0,0 +1,144 @@
+#include "dagSched/AllocAccounting.h"
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+namespace dagSched{
+
+thread_local allocStats* current_alloc_stats = nullptr;
+thread_local uint64_t current_alloc_scope = 0;   // 当前作用域的编号, 0表示没有作用域
+
+std::atomic<uint64_t> next_alloc_scope (1);
+
+AllocScope::AllocScope(allocStats& stats): previous(current_alloc_stats), previousId(current_alloc_scope){
+    current_alloc_stats = &stats;
+    current_alloc_scope = next_alloc_scope.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocScope::~AllocScope(){
+    current_alloc_stats = previous;
+    current_alloc_scope = previousId;
+}
+
+#ifdef ALLOC_ACCOUNTING
+
+bool allocAccountingEnabled(){
+    return true;
+}
+
+namespace{
+
+// 每块内存前的记录, 大小保持operator new要求的对齐
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) allocHeader{
+    uint64_t size;
+    uint64_t scope;
+};
+
+void* accountedMalloc(const std::size_t size){
+    allocHeader* h = (allocHeader*) std::malloc(sizeof(allocHeader) + size);
+    if(h == nullptr)
+        return nullptr;
+
+    h->size = size;
+    h->scope = current_alloc_scope;
+    if(current_alloc_stats != nullptr){
+        allocStats& s = *current_alloc_stats;
+        s.allocations++;
+        s.bytes += size;
+        s.liveBytes += size;
+        if(s.liveBytes > 0 && (uint64_t) s.liveBytes > s.peakBytes)
+            s.peakBytes = s.liveBytes;
+    }
+    return h + 1;
+}
+
+void accountedFree(void* p){
+    if(p == nullptr)
+        return;
+
+    allocHeader* h = (allocHeader*) p - 1;
+    if(current_alloc_stats != nullptr && h->scope == current_alloc_scope)
+        current_alloc_stats->liveBytes -= h->size;
+    std::free(h);
+}
+
+void* accountedNew(const std::size_t size){
+    while(true){
+        void* p = accountedMalloc(size);
+        if(p != nullptr)
+            return p;
+
+        std::new_handler handler = std::get_new_handler();
+        if(handler == nullptr)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+}
+
+#else
+
+bool allocAccountingEnabled(){
+    return false;
+}
+
+#endif
+
+}
+
+#ifdef ALLOC_ACCOUNTING
+
+// 替换全局的operator new/delete, 对齐版本使用标准库的实现
+void* operator new(std::size_t size){
+    return dagSched::accountedNew(size);
+}
+
+void* operator new[](std::size_t size){
+    return dagSched::accountedNew(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return dagSched::accountedNew(size);
+    }
+    catch(...){
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return dagSched::accountedNew(size);
+    }
+    catch(...){
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept{
+    dagSched::accountedFree(p);
+}
+
+void operator delete[](void* p) noexcept{
+    dagSched::accountedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept{
+    dagSched::accountedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept{
+    dagSched::accountedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept{
+    dagSched::accountedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept{
+    dagSched::accountedFree(p);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include "dagSched/AnalysisBudget.h"
+
+#include <algorithm>
+
+namespace dagSched{
+
+thread_local AnalysisBudget* current_budget = nullptr;
+
+AnalysisBudget::AnalysisBudget(const double time_limit, const uint64_t max_iterations):
+    start(clock::now()), timeLimit(time_limit), maxIterations(max_iterations){}
+
+bool AnalysisBudget::step(){
+    if(exhausted)
+        return true;
+
+    ++iterations;
+    if(maxIterations > 0 && iterations > maxIterations)
+        exhausted = true;
+    else if(timeLimit > 0 && std::chrono::duration<double>(clock::now() - start).count() > timeLimit)
+        exhausted = true;
+
+    return exhausted;
+}
+
+double AnalysisBudget::remainingTime() const{
+    const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    return std::max(timeLimit - elapsed, 1e-3);
+}
+
+BudgetScope::BudgetScope(AnalysisBudget& budget): previous(current_budget){
+    current_budget = &budget;
+}
+
+BudgetScope::~BudgetScope(){
+    current_budget = previous;
+}
+
+AnalysisBudget* currentBudget(){
+    return current_budget;
+}
+
+bool budgetExhausted(){
+    return current_budget != nullptr && current_budget->step();
+}
+
+}
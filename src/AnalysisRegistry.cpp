@@ -0,0 +1,201 @@
+#include "dagSched/AnalysisRegistry.h"
+#include "dagSched/tests.h"
+#include "dagSched/utils.h"
+
+#include <algorithm>
+
+namespace dagSched{
+
+template<typename T>
+bool supportsValue(const std::vector<T>& supported, const T value){
+    return supported.empty() || std::find(supported.begin(), supported.end(), value) != supported.end();
+}
+
+bool AnalysisInfo::supports(const GeneratorParams& gp) const{
+    if(singleDAG && gp.wType != workloadType_t::SINGLE_DAG)
+        return false;
+    return  supportsValue(sTypes, gp.sType) && supportsValue(dTypes, gp.dtype) &&
+            supportsValue(aTypes, gp.aType) && supportsValue(DAGTypes, gp.DAGType);
+}
+
+AnalysisRegistry& AnalysisRegistry::instance(){
+    static AnalysisRegistry registry;
+    return registry;
+}
+
+void AnalysisRegistry::add(const AnalysisInfo& a){
+    if(!a.run)
+        FatalError("The analysis " + a.name + " has no entry point");
+    analyses.push_back(a);
+}
+
+bool AnalysisRegistry::contains(const std::string& name) const{
+    for(const auto& a: analyses)
+        if(a.name == name)
+            return true;
+    return false;
+}
+
+std::vector<const AnalysisInfo*> AnalysisRegistry::buildPlan(const GeneratorParams& gp) const{
+    for(const auto& name: gp.analyses)
+        if(!contains(name))
+            FatalError("Unknown analysis " + name);
+
+    std::vector<const AnalysisInfo*> plan;
+    for(const auto& a: analyses){
+        if(!a.supports(gp) || a.cost > gp.maxCost)
+            continue;
+        if(!gp.analyses.empty() && std::find(gp.analyses.begin(), gp.analyses.end(), a.name) == gp.analyses.end())
+            continue;
+        plan.push_back(&a);
+    }
+    return plan;
+}
+
+// 内置的分析
+// 同一任务集上运行时结果的顺序即为注册顺序
+AnalysisRegistry::AnalysisRegistry(){
+    const std::vector<DeadlinesType_t> CI = {DeadlinesType_t::CONSTRAINED, DeadlinesType_t::IMPLICIT};
+    const std::vector<DeadlinesType_t> A = {DeadlinesType_t::ARBITRARY};
+    const std::vector<SchedulingType_t> G = {SchedulingType_t::GLOBAL};
+    const std::vector<SchedulingType_t> G_SOTA = {SchedulingType_t::GLOBAL, SchedulingType_t::SOTA};
+    const std::vector<SchedulingType_t> P_SOTA = {SchedulingType_t::PARTITIONED, SchedulingType_t::SOTA};
+    const std::vector<AlgorithmType_t> EDF = {AlgorithmType_t::EDF};
+    const std::vector<AlgorithmType_t> FTP = {AlgorithmType_t::FTP};
+
+    AnalysisInfo a;
+
+    // 全局调度, 单个DAG任务
+    a = AnalysisInfo();
+    a.name = "Graham1969";
+    a.sTypes = G; a.dTypes = A; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.singleDAG = true;
+    a.cost = CostClass_t::CHEAP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return Graham1969(ts.tasks[0], m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Baruah2012";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = EDF; a.DAGTypes = {DAGType_t::DAG};
+    a.singleDAG = true;
+    a.cost = CostClass_t::CHEAP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Baruah2012_C(ts.tasks[0], m); };
+    add(a);
+
+    a.dTypes = A;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Baruah2012_A(ts.tasks[0], m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Han2019";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::TDAG};
+    a.singleDAG = true;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_Han2019_C_1(ts.tasks[0], gp.typedProc); };
+    add(a);
+
+    // 全局调度, 任务集
+    a = AnalysisInfo();
+    a.name = "Bonifaci2013";
+    a.sTypes = G; a.dTypes = A; a.aTypes = EDF; a.DAGTypes = {DAGType_t::DAG};
+    a.cost = CostClass_t::CHEAP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Bonifaci2013_A(ts, m); };
+    add(a);
+
+    a.aTypes = FTP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_DM_Bonifaci2013_A(ts, m); };
+    add(a);
+
+    a.dTypes = CI;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_DM_Bonifaci2013_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Li2013";
+    a.sTypes = G; a.dTypes = {DeadlinesType_t::IMPLICIT}; a.aTypes = EDF; a.DAGTypes = {DAGType_t::DAG};
+    a.cost = CostClass_t::CHEAP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Li2013_I(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Qamhieh2013";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = EDF; a.DAGTypes = {DAGType_t::DAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Qamhieh2013_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Melani2015";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = EDF; a.DAGTypes = {DAGType_t::DAG, DAGType_t::CDAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_EDF_Melani2015_C(ts, m); };
+    add(a);
+
+    a.sTypes = G_SOTA; a.aTypes = FTP;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_FTP_Melani2015_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Serrano2016";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_LP_FTP_Serrano16_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Pathan2017";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG, DAGType_t::CDAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_DM_Pathan2017_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Fonseca2017";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_FTP_Fonseca2017_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "Fonseca2019";
+    a.sTypes = G_SOTA; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_FTP_Fonseca2019(ts, m); };
+    add(a);
+
+    a.sTypes = G; a.dTypes = A;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_FTP_Fonseca2019(ts, m, false); };
+    add(a);
+
+    // 分析由外部库完成, 不与其他分析并发
+    a = AnalysisInfo();
+    a.name = "Nasri2019";
+    a.sTypes = G_SOTA; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.cost = CostClass_t::EXPENSIVE;
+    a.parallelSafe = false;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return G_LP_FTP_Nasri2019_C(ts, m); };
+    add(a);
+
+    a = AnalysisInfo();
+    a.name = "He2019";
+    a.sTypes = G; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return GP_FP_FTP_He2019_C(ts, m); };
+    add(a);
+
+    // 分区调度, 子任务先按WorstFit分配到处理器
+    a = AnalysisInfo();
+    a.name = "Fonseca2016";
+    a.sTypes = P_SOTA; a.dTypes = CI; a.aTypes = FTP; a.DAGTypes = {DAGType_t::DAG};
+    a.needsPartitioning = true;
+    a.cost = CostClass_t::EXPENSIVE;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return P_FP_FTP_Fonseca2016_C(ts, m); };
+    add(a);
+
+    a.name = "Casini2018";
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return P_LP_FTP_Casini2018_C(ts, m); };
+    add(a);
+
+    #ifdef ZAHAF2019
+    // 通过固定的临时文件调用外部求解器, 不与其他分析并发
+    a.name = "Zahaf2019";
+    a.sTypes = {SchedulingType_t::PARTITIONED};
+    a.parallelSafe = false;
+    a.run = [](const Taskset& ts, const int m, const GeneratorParams& gp){ return P_LP_EDF_Zahaf2019_C(ts, m); };
+    add(a);
+    #endif
+}
+
+}
@@ -0,0 +1,59 @@
+#include "dagSched/CSRGraph.h"
+
+namespace dagSched{
+
+// 从指针图构建CSR
+// V: 顶点集合, V[i]->id必须等于i
+void CSRGraph::build(const std::vector<SubTask*>& V){
+    const int n = V.size();
+
+    succOffset.assign(n + 1, 0);
+    predOffset.assign(n + 1, 0);
+    c.resize(n);
+
+    // 统计度数并计算偏移
+    for(int i=0; i<n; ++i){
+        if(V[i]->id != i)
+            FatalError("Ids and Indexes do not correspond, can't build CSR graph!");
+        succOffset[i+1] = succOffset[i] + V[i]->succ.size();
+        predOffset[i+1] = predOffset[i] + V[i]->pred.size();
+        c[i] = V[i]->c;
+    }
+
+    // 填充邻居数组, 保持原有的邻居顺序
+    succIdx.resize(succOffset[n]);
+    predIdx.resize(predOffset[n]);
+    for(int i=0; i<n; ++i){
+        int *s = succIdx.data() + succOffset[i];
+        for(const auto& w: V[i]->succ)
+            *s++ = w->id;
+
+        int *p = predIdx.data() + predOffset[i];
+        for(const auto& w: V[i]->pred)
+            *p++ = w->id;
+    }
+}
+
+// Kahn算法: 按入度为0的顺序依次弹出顶点, O(V+E)
+// order: 输出的拓扑序
+// 返回: 图是否无环
+bool CSRGraph::kahnOrder(std::vector<int>& order) const{
+    const int n = size();
+    order.clear();
+    order.reserve(n);
+
+    std::vector<int> indeg(n);
+    for(int i=0; i<n; ++i){
+        indeg[i] = inDegree(i);
+        if(indeg[i] == 0)
+            order.push_back(i);
+    }
+    for(size_t h=0; h<order.size(); ++h)
+        for(const int* s = succBegin(order[h]); s != succEnd(order[h]); ++s)
+            if(--indeg[*s] == 0)
+                order.push_back(*s);
+
+    return (int)order.size() == n;
+}
+
+}
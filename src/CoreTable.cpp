@@ -0,0 +1,54 @@
+#include "dagSched/CoreTable.h"
+
+#include <algorithm>
+
+namespace dagSched{
+
+void CoreTable::build(const Taskset& taskset){
+    nTasks = taskset.tasks.size();
+    nCores = 1;
+    for(const auto& t: taskset.tasks)
+        for(const auto v: t.getVertices())
+            nCores = std::max(nCores, v->core + 1);
+
+    const int n_slots = nTasks * nCores;
+    vol.assign(n_slots, 0);
+    maxR.assign(n_slots, 0);
+    vertOffset.assign(n_slots + 1, 0);
+
+    // 计数排序: 先统计每个(任务, 处理器)上的顶点数, 再按顶点索引顺序填入
+    for(int x=0; x<nTasks; ++x)
+        for(const auto v: taskset.tasks[x].getVertices())
+            if(inRange(v->core))
+                vertOffset[slot(x, v->core) + 1]++;
+    for(int s=0; s<n_slots; ++s)
+        vertOffset[s + 1] += vertOffset[s];
+
+    vertIdx.resize(vertOffset[n_slots]);
+    std::vector<int> fill(vertOffset.begin(), vertOffset.end() - 1);
+    for(int x=0; x<nTasks; ++x){
+        const std::vector<SubTask*>& V = taskset.tasks[x].getVertices();
+        for(int i=0; i<V.size(); ++i)
+            if(inRange(V[i]->core))
+                vertIdx[fill[slot(x, V[i]->core)]++] = i;
+
+        // 体积直接取自任务, 与按顶点顺序累加的结果完全一致
+        for(int core=0; core<nCores; ++core)
+            vol[slot(x, core)] = taskset.tasks[x].getpVolume(core);
+    }
+}
+
+void CoreTable::updateMaxResponse(const AnalysisScratch& scratch){
+    for(int x=0; x<nTasks; ++x){
+        const std::vector<Time_t>& r = scratch[x].r;
+        for(int core=0; core<nCores; ++core){
+            Time_t max_r = 0;
+            for(const int* j = verticesBegin(x, core); j != verticesEnd(x, core); ++j)
+                if(r[*j] > max_r)
+                    max_r = r[*j];
+            maxR[slot(x, core)] = max_r;
+        }
+    }
+}
+
+}
@@ -1,37 +1,188 @@
 #include "dagSched/DAGTask.h"
+#include "dagSched/WorkloadArtifacts.h"
 
 namespace dagSched{
 
+// 在任务的顶点内存池中创建子任务, 内存池不存在时先创建
+// 返回: 新的空子任务, 其生命周期由内存池管理
+SubTask* DAGTask::createSubTask(){
+    if(!arena)
+        arena = std::make_shared<VertexArena>();
+    if(!versions)
+        ownVertices();
+    return arena->create();
+}
+
 // 克隆顶点集合
-// to_clone_V: 要克隆的顶点集合
+// 克隆使用新的内存池, 其大小预先计算, 使所有顶点和邻接表只需一次分配
+// 克隆的是任务自身的顶点时(任务副本), 图结构与WCET不变, 缓存继续有效
+// 克隆后的顶点只属于本任务, 修改不再影响其他副本
+// to_clone_V: 要克隆的顶点集合(顶点ID须与索引一致)
 void DAGTask::cloneVertices(const std::vector<SubTask*>& to_clone_V){
+    checkShared();
+    ownVertices();
+    if(to_clone_V != V)
+        invalidateGraph();
     V.clear();
-    // 克隆每个顶点
+    const std::shared_ptr<VertexArena> old_arena = arena; // 源顶点可能位于当前内存池中
+
+    size_t bytes = 0;
+    for(const auto& v: to_clone_V)
+        bytes += sizeof(SubTask) + (v->succ.size() + v->pred.size()) * sizeof(SubTask*) + 2 * alignof(std::max_align_t);
+    arena = std::make_shared<VertexArena>(std::max(bytes, size_t(1)));
+
+    // 复制顶点内容, 邻接表按原大小分配在新内存池中
+    V.reserve(to_clone_V.size());
     for(int i=0; i<to_clone_V.size();++i){
-        SubTask * v = new SubTask;
-        *v = *to_clone_V[i];  // 复制顶点内容
+        SubTask * v = arena->create();
+        *v = *to_clone_V[i];
         V.push_back(v);
     }
 
-    // 重建顶点间的连接关系
-    for(int i=0; i<to_clone_V.size();++i){
-        V[i]->pred.clear();
-        V[i]->succ.clear();
-
-        // 重建后继关系
-        for(int j=0; j<to_clone_V[i]->succ.size();++j)
-            V[i]->succ.push_back(V[to_clone_V[i]->succ[j]->id]);
-
-        // 重建前驱关系
-        for(int j=0; j<to_clone_V[i]->pred.size();++j)
-            V[i]->pred.push_back(V[to_clone_V[i]->pred[j]->id]);
+    // 将邻接表中的指针重映射到克隆的顶点
+    for(auto& v: V){
+        for(auto& s: v->succ)
+            s = V[s->id];
+        for(auto& p: v->pred)
+            p = V[p->id];
     }
 }
 
 // 销毁所有顶点
+// 顶点由内存池统一释放; 共享同一内存池的任务副本全部释放后内存才会归还
 void DAGTask::destroyVerices(){
-    for(int i=0; i<V.size();++i)
-        delete V[i];  // 释放每个顶点内存
+    V.clear();
+    arena.reset();
+    versions.reset();
+    invalidateGraph();
+}
+
+// 使用新的修改计数: 顶点集合改变后, 其他副本的修改与本任务无关
+void DAGTask::ownVertices(){
+    versions = std::make_shared<vertexVersions>();
+    seenAny = seenGraph = seenWCET = seenAssignment = 0;
+}
+
+// 记录对共享顶点的一次修改
+// 先处理其他副本尚未同步的修改, 再增加对应的计数; 本副本的缓存由调用者处理
+// counter: 修改对应的计数
+// seen: 本副本中与counter对应的已处理计数值
+void DAGTask::recordChange(std::atomic<unsigned>& counter, unsigned& seen){
+    checkShared();
+    seen = ++counter;
+    seenAny = ++versions->any;
+}
+
+// 其他副本修改了共享顶点: 按修改的种类使本副本的缓存与派生指标失效
+void DAGTask::syncShared() const{
+    const unsigned any = versions->any;
+    const unsigned graph = versions->graph;
+    const unsigned wcet = versions->wcet;
+    const unsigned assignment = versions->assignment;
+
+    if(graph != seenGraph){
+        csr.reset();
+        reach.reset();
+        artifacts.reset();
+        dirty = ALL_D;
+    }
+    else if(wcet != seenWCET){
+        csr.reset();
+        artifacts.reset();
+        dirty = ALL_D;
+    }
+    if(assignment != seenAssignment)
+        dirty |= P_VOL_D | TYPED_VOL_D;
+
+    seenAny = any;
+    seenGraph = graph;
+    seenWCET = wcet;
+    seenAssignment = assignment;
+}
+
+// 使图结构缓存及派生指标失效, 在边或顶点改变后调用
+// 共享顶点的其他副本在下次访问时同样失效
+void DAGTask::invalidateGraph(){
+    if(versions)
+        recordChange(versions->graph, seenGraph);
+    csr.reset();
+    reach.reset();
+    artifacts.reset();
+    dirty = ALL_D;
+}
+
+// 使依赖WCET的缓存失效, 可达性矩阵只依赖图结构, 予以保留
+void DAGTask::invalidateWCET(){
+    if(versions)
+        recordChange(versions->wcet, seenWCET);
+    csr.reset();
+    artifacts.reset();
+    dirty = ALL_D;
+}
+
+// 构建CSR邻接表示, 应在传递约简之后调用
+void DAGTask::buildCSR(){
+    csr = std::make_shared<const CSRGraph>(V);
+}
+
+// 获取CSR邻接表示, 若尚未构建则按需构建
+const CSRGraph& DAGTask::getCSR() const{
+    checkShared();
+    if(!csr)
+        csr = std::make_shared<const CSRGraph>(V);
+    return *csr;
+}
+
+// 获取可达性矩阵, 若尚未构建则按需构建
+const ReachabilityMatrix& DAGTask::getReachability() const{
+    checkShared();
+    if(!reach)
+        reach = std::make_shared<ReachabilityMatrix>(getCSR());
+    return *reach;
+}
+
+// 获取工作负载分布缓存, 若不存在则创建一个空的缓存
+// 在复制任务之前创建(computeMetrics), 所有副本共享同一个缓存对象
+workloadArtifactCache& DAGTask::getArtifactCache() const{
+    checkShared();
+    if(!artifacts)
+        artifacts = std::make_shared<workloadArtifactCache>();
+    return *artifacts;
+}
+
+// 取出可达性矩阵以便在图改变后增量更新
+// 矩阵与其他副本共享时(其他线程可能正在读取)不能原地修改, 返回空, 由调用者使其失效
+std::shared_ptr<ReachabilityMatrix> DAGTask::takeReachability(){
+    checkShared();
+    if(!reach || reach.use_count() > 1 || reach->size() != V.size())
+        return nullptr;
+    return std::move(reach);
+}
+
+// 添加边 from -> to, 并使图结构缓存失效
+// 可达性矩阵已构建且只被本任务持有时增量更新, 而不是下次查询时重新计算
+void DAGTask::addEdge(SubTask* from, SubTask* to){
+    std::shared_ptr<ReachabilityMatrix> r = takeReachability();
+    from->succ.push_back(to);
+    to->pred.push_back(from);
+    invalidateGraph();
+    if(r && from != to && !r->reaches(to->id, from->id)){
+        r->addEdge(from->id, to->id);
+        reach = r;
+    }
+}
+
+// 删除边 from -> to, 并使图结构缓存失效
+// 可达性矩阵已构建且只被本任务持有时增量更新, 而不是下次查询时重新计算
+void DAGTask::removeEdge(SubTask* from, SubTask* to){
+    std::shared_ptr<ReachabilityMatrix> r = takeReachability();
+    from->succ.erase(std::remove(from->succ.begin(), from->succ.end(), to), from->succ.end());
+    to->pred.erase(std::remove(to->pred.begin(), to->pred.end(), from), to->pred.end());
+    invalidateGraph();
+    if(r){
+        r->removeEdge(from->id, to->id, V);
+        reach = r;
+    }
 }
 
 // 判断顶点v是否是w的后继
@@ -39,124 +190,127 @@ void DAGTask::destroyVerices(){
 // w: 起始顶点
 // is_succ: 输出参数，表示是否为后继
 void DAGTask::isSuccessor(const SubTask* v, const SubTask *w, bool &is_succ) const{
-    for(size_t i=0; i<w->succ.size(); ++i){
-        if(w->succ[i] == v){
-            is_succ = true;
-            return;
-        }
-        else{
-            // 递归检查后继的后继
-            isSuccessor(v, w->succ[i], is_succ);
-        }
-    }
-    return;
+    if(getReachability().reaches(w->id, v->id))
+        is_succ = true;
 }
 
 // 获取顶点的所有祖先
 // i: 顶点索引
-// 返回: 祖先顶点集合
+// 返回: 祖先顶点集合(按索引升序)
 std::vector<SubTask*> DAGTask::getSubTaskAncestors(const int i) const{
+    const ReachabilityMatrix& r = getReachability();
     std::vector<SubTask*> ancst;
-    bool is_succ = false;
-    for(int j=0; j<V.size(); ++j){
-        is_succ = false;
-        isSuccessor(V[i], V[j], is_succ);
-        if( is_succ )
-            ancst.push_back(V[j]);
-    }
+    ancst.reserve(r.countAncestors(i));
+    r.forEachAncestor(i, [&](const int j){ ancst.push_back(V[j]); });
     return ancst;
 }
 
 // 获取顶点的所有后代
 // i: 顶点索引
-// 返回: 后代顶点集合
+// 返回: 后代顶点集合(按索引升序)
 std::vector<SubTask*> DAGTask::getSubTaskDescendants(const int i) const{
+    const ReachabilityMatrix& r = getReachability();
     std::vector<SubTask*> desc;
-    bool is_succ = false;
-    for(int j=0; j<V.size(); ++j){
-        is_succ = false;
-        isSuccessor(V[j], V[i], is_succ);
-        if( is_succ )
-            desc.push_back(V[j]);
-    }
+    desc.reserve(r.countDescendants(i));
+    r.forEachDescendant(i, [&](const int j){ desc.push_back(V[j]); });
     return desc;
 }
 
 // 执行传递归约，移除冗余边
+// 在按逆拓扑序计算后代位集合的同时标记冗余边, 复杂度约为O(V·E/64)
+// 传递归约不改变可达性, 因此计算得到的可达性矩阵直接作为约简后图的缓存
 void DAGTask::transitiveReduction(){
+    const CSRGraph& g = getCSR();
+    std::vector<char> redundant;
+    auto closure = std::make_shared<ReachabilityMatrix>();
+    closure->build(g, &redundant);
+
+    // 被移除边的起点, 按终点分组
+    std::vector<std::vector<int>> removed_pred(V.size());
+    bool any_removed = false;
+
+    // 按原有顺序保留非冗余后继
     for(int i=0; i<V.size(); ++i){
-        std::vector<SubTask*> succ_desc;
-        // 收集所有后继的后代
-        for(int j=0; j<V[i]->succ.size();++j){
-            std::vector<SubTask*> succ_desc_j = getSubTaskDescendants(V[i]->succ[j]->id);
-            succ_desc.insert(succ_desc.end(), succ_desc_j.begin(), succ_desc_j.end());
-        }
-        
-        // 标记需要移除的边
-        std::vector<SubTask*> to_remove;
-        for(int j=0; j<V[i]->succ.size();++j){
-            if ( std::find(succ_desc.begin(), succ_desc.end(), V[i]->succ[j]) != succ_desc.end() ){
-                to_remove.push_back(V[i]->succ[j]);
+        const int first = g.succOffset[i];
+        bool has_redundant = false;
+        for(int e = first; e < g.succOffset[i+1]; ++e)
+            if(redundant[e]){
+                has_redundant = true;
+                removed_pred[g.succIdx[e]].push_back(i);
             }
-        }
-
-        // 移除冗余边
-        for(auto& r:to_remove){
-            V[i]->succ.erase(std::remove(V[i]->succ.begin(), V[i]->succ.end(), r), V[i]->succ.end());
-            r->pred.erase(std::remove(r->pred.begin(), r->pred.end(), V[i]), r->pred.end());
-        }
+        if(!has_redundant)
+            continue;
+
+        any_removed = true;
+        int k = 0;
+        for(int e = first; e < g.succOffset[i+1]; ++e)
+            if(!redundant[e])
+                V[i]->succ[k++] = V[i]->succ[e - first];
+        V[i]->succ.resize(k);
     }
-}
 
-// 检查所有前驱是否已添加
-// pred: 前驱顶点集合
-// ids: 已添加顶点ID集合
-// 返回: 是否所有前驱都已添加
-bool DAGTask::allPrecAdded(std::vector<SubTask*> pred, std::vector<int> ids){
-    bool prec_present;
-    for(int i=0; i<pred.size();++i){
-        prec_present = false;
-        for(int j=0; j<ids.size();++j){
-            if(pred[i]->id == ids[j]){
-                prec_present = true;
-                break;
-            }
+    // 从终点的前驱中移除对应起点, 保持前驱顺序
+    if(any_removed){
+        std::vector<char> mark(V.size(), 0);
+        for(int r=0; r<V.size(); ++r){
+            if(removed_pred[r].empty())
+                continue;
+            for(const int p: removed_pred[r])
+                mark[p] = 1;
+            auto& pred = V[r]->pred;
+            pred.erase(std::remove_if(pred.begin(), pred.end(), [&](const SubTask* p){ return mark[p->id]; }), pred.end());
+            for(const int p: removed_pred[r])
+                mark[p] = 0;
         }
-        if(!prec_present)
-            return false;
+        // 可达性不变, 但其他副本无从得知, 按图结构的修改记录
+        if(versions)
+            recordChange(versions->graph, seenGraph);
+        csr.reset();
+        artifacts.reset();
+        dirty = ALL_D;
     }
-    return true;
+    reach = closure;
 }
 
 // 执行拓扑排序
+// 使用Kahn算法(O(V+E))计算每个顶点的轮次与层次, 再按(轮次, ID)排序。
+// 轮次与按ID顺序反复扫描顶点、加入所有前驱均已加入的顶点所得到的轮次一致:
+// 前驱u的ID小于v时v可与u在同一轮加入, 否则v最早在u的下一轮加入,
+// 因此得到的序列是确定的, 且与此前逐轮扫描的实现完全相同。
+// 层次为从源点出发的最长路径边数。
 void DAGTask::topologicalSort (){
-    std::vector<SubTask> V_copy;
-    ordIDs.clear();
-
-    // 创建顶点副本
-    for(const auto &v: V)
-        V_copy.push_back(*v);
-
-    bool nodes_to_add = true;
-    while(nodes_to_add){
-        nodes_to_add = false;
-        for(auto &v: V_copy){
-            if((v.pred.empty() || allPrecAdded(v.pred, ordIDs))){
-                if(v.id != -1 ){
-                    ordIDs.push_back(v.id);
-                    v.id = -1;
-                }                    
-            }
-            else
-                nodes_to_add = true;
+    if(!checkIndexAndIdsAreEqual())
+        FatalError("Ids and Indexes do not correspond, can't use computed topological order!");
+
+    const CSRGraph& g = getCSR();
+    const int n = g.size();
+
+    std::vector<int> kahn;
+    if(!g.kahnOrder(kahn))
+        FatalError("The graph contains a cycle, can't compute the topological order!");
+
+    // 计算轮次与层次
+    std::vector<int> pass(n, 0);
+    topoLevels.assign(n, 0);
+    int max_pass = 0;
+    for(const int v: kahn){
+        for(const int* p = g.predBegin(v); p != g.predEnd(v); ++p){
+            pass[v] = std::max(pass[v], *p < v ? pass[*p] : pass[*p] + 1);
+            topoLevels[v] = std::max(topoLevels[v], topoLevels[*p] + 1);
         }
+        max_pass = std::max(max_pass, pass[v]);
     }
 
-    // 验证排序结果
-    if(!checkIndexAndIdsAreEqual())
-        FatalError("Ids and Indexes do not correspond, can't use computed topological order!");
-    if(ordIDs.size() != V.size())
-        FatalError("Ids and V sizes differ!");
+    // 按轮次分桶, 桶内按ID升序
+    std::vector<int> start(max_pass + 2, 0);
+    for(int v=0; v<n; ++v)
+        start[pass[v] + 1]++;
+    for(int p=0; p<=max_pass; ++p)
+        start[p + 1] += start[p];
+
+    ordIDs.resize(n);
+    for(int v=0; v<n; ++v)
+        ordIDs[start[pass[v]]++] = v;
 }
 
 // 检查顶点ID与索引是否一致
@@ -170,22 +324,34 @@ bool DAGTask::checkIndexAndIdsAreEqual(){
 
 // 计算DAG的总工作量(volume)
 void DAGTask::computeVolume(){
+    updateVolume();
+}
+
+void DAGTask::updateVolume() const{
+    const CSRGraph& g = getCSR();
     vol = 0;
-    for(size_t i=0; i<V.size();++i)
-        vol += V[i]->c;  // 累加所有顶点的WCET
+    for(int i=0; i<g.size();++i)
+        vol += g.c[i];  // 累加所有顶点的WCET
+    dirty &= ~VOLUME_D;
 }
 
 // 计算最坏情况工作量(WCW)
 void DAGTask::computeWorstCaseWorkload(){
-    // 基于Melani等人的算法，计算DAG和条件DAG的工作量
     if(!ordIDs.size())
         topologicalSort();
+    updateWorstCaseWorkload();
+}
+
+void DAGTask::updateWorstCaseWorkload() const{
+    // 基于Melani等人的算法，计算DAG和条件DAG的工作量
+    std::vector<int> tmp;
+    const std::vector<int>& ord = topologicalOrder(tmp);
 
     std::vector<std::set<int>> paths (V.size());
-    paths[ordIDs[ordIDs.size()-1]].insert(ordIDs[ordIDs.size()-1]);
+    paths[ord[ord.size()-1]].insert(ord[ord.size()-1]);
     int idx;
-    for(int i = ordIDs.size()-2; i >= 0; --i ){
-        idx = ordIDs[i];
+    for(int i = ord.size()-2; i >= 0; --i ){
+        idx = ord[i];
         paths[idx].insert(idx);
 
         if(V[idx]->succ.size()){
@@ -214,23 +380,34 @@ void DAGTask::computeWorstCaseWorkload(){
 
     // 计算总工作量
     wcw = 0;
-    for(auto i:paths[ordIDs[0]]){
+    for(auto i:paths[ord[0]]){
         wcw += V[i]->c;
     }
+    dirty &= ~WCW_D;
 }
 
 // 计算类型化工作量(按处理器类型分组)
 void DAGTask::computeTypedVolume(){
+    updateTypedVolume();
+}
+
+void DAGTask::updateTypedVolume() const{
+    typedVol.clear();
     for(size_t i=0; i<V.size();++i){
         if ( typedVol.find(V[i]->gamma) == typedVol.end() ) 
             typedVol[V[i]->gamma] = V[i]->c;
         else
             typedVol[V[i]->gamma] += V[i]->c;
     }
+    dirty &= ~TYPED_VOL_D;
 }
 
 // 计算分区工作量(按处理器核心分组)
 void DAGTask::computepVolume(){
+    updatepVolume();
+}
+
+void DAGTask::updatepVolume() const{
     pVol.clear();
     for(size_t i=0; i<V.size();++i){
         if ( pVol.find(V[i]->core) == pVol.end() ) 
@@ -238,21 +415,48 @@ void DAGTask::computepVolume(){
         else
             pVol[V[i]->core] += V[i]->c;
     }
+    dirty &= ~P_VOL_D;
+}
+
+// 设置子任务分配的核心, 共享顶点的其他副本的分区体积同样失效
+void DAGTask::setSubTaskCore(const int i, const int core){
+    V[i]->core = core;
+    if(versions)
+        recordChange(versions->assignment, seenAssignment);
+    dirty |= P_VOL_D;
+}
+
+// 设置子任务的核心类型, 共享顶点的其他副本的类型化体积同样失效
+void DAGTask::setSubTaskType(const int i, const int gamma){
+    V[i]->gamma = gamma;
+    if(versions)
+        recordChange(versions->assignment, seenAssignment);
+    dirty |= TYPED_VOL_D;
+}
+
+// 获取分配到某核心上的顶点的总工作量
+// core: 核心ID
+// 返回: 分区体积, 该核心上没有顶点时为0
+Time_t DAGTask::getpVolume(const int core) const{
+    const std::map<int, Time_t>& p_vol = getpVolume();
+    const auto it = p_vol.find(core);
+    return it == p_vol.end() ? 0 : it->second;
 }
 
 // 计算累计工作量
 void DAGTask::computeAccWorkload(){
+    const CSRGraph& g = getCSR();
     int max_acc_prec;
-    for(size_t i=0; i<ordIDs.size();++i){
+    for(const auto i: ordIDs){
         max_acc_prec = 0;
         // 找出最大前驱累计工作量
-        for(size_t j=0; j<V[ordIDs[i]]->pred.size();++j){
-            if(V[ordIDs[i]]->pred[j]->accWork > max_acc_prec)
-                max_acc_prec = V[ordIDs[i]]->pred[j]->accWork;
+        for(const int *p = g.predBegin(i); p != g.predEnd(i); ++p){
+            if(V[*p]->accWork > max_acc_prec)
+                max_acc_prec = V[*p]->accWork;
         }
 
         // 当前顶点累计工作量 = 自身WCET + 最大前驱累计工作量
-        V[ordIDs[i]]->accWork = V[ordIDs[i]]->c + max_acc_prec;
+        V[i]->accWork = g.c[i] + max_acc_prec;
     }
 }
 
@@ -260,26 +464,154 @@ void DAGTask::computeAccWorkload(){
 void DAGTask::computeLength(){
     if(!ordIDs.size())
         topologicalSort();
-    L = 0;    
-    computeAccWorkload();
-    // 找出最大累计工作量即为关键路径长度
-    for(const auto&v :V)
-        if(v->accWork > L)
-            L = v->accWork;
+    updateLength();
+}
+
+void DAGTask::updateLength() const{
+    // 按拓扑序在CSR上计算累计工作量, 不写回顶点
+    std::vector<int> tmp;
+    const std::vector<int>& ord = topologicalOrder(tmp);
+    const CSRGraph& g = getCSR();
+    std::vector<Time_t> acc(g.size(), 0);
+    int max_acc_prec;
+    L = 0;
+    for(const auto i: ord){
+        max_acc_prec = 0;
+        for(const int *p = g.predBegin(i); p != g.predEnd(i); ++p)
+            if(acc[*p] > max_acc_prec)
+                max_acc_prec = acc[*p];
+        acc[i] = g.c[i] + max_acc_prec;
+
+        // 最大累计工作量即为关键路径长度
+        if(acc[i] > L)
+            L = acc[i];
+    }
+    dirty &= ~LENGTH_D;
 }
 
 // 计算DAG的利用率
+// 利用率 = 最坏情况工作量 / 周期, 由getUtilization()直接计算, 此处只需保证wcw为最新
 void DAGTask::computeUtilization(){
-    if(vol == 0)
+    checkShared();
+    if(dirty & WCW_D)
         computeWorstCaseWorkload();
-    u =  wcw /  t;  // 利用率 = 最坏情况工作量 / 周期
 }
 
 // 计算DAG的密度
+// 密度 = 关键路径长度 / 截止时间, 由getDensity()直接计算, 此处只需保证L为最新
 void DAGTask::computeDensity(){
-    if(L == 0)
+    checkShared();
+    if(dirty & LENGTH_D)
         computeLength();
-    delta =  L /  d;  // 密度 = 关键路径长度 / 截止时间
+}
+
+// 计算本地偏移量/截止时间及对应的EFT/LST缓存
+void DAGTask::updateOffsets() const{
+    computeEFTs(localO, EFT);
+    dirty &= ~OFFSETS_D;
+}
+
+void DAGTask::updateDeadlines() const{
+    computeLSTs(localD, LST);
+    dirty &= ~DEADLINES_D;
+}
+
+// 计算所有派生指标
+// 任务集中的任务在分析时按值复制, 在复制之前计算可使各副本直接使用缓存结果
+void DAGTask::computeMetrics(){
+    checkShared();
+    if(!ordIDs.size())
+        topologicalSort();
+    getArtifactCache();
+    if(dirty & WCW_D)
+        updateWorstCaseWorkload();
+    if(dirty & LENGTH_D)
+        updateLength();
+    if(dirty & VOLUME_D)
+        updateVolume();
+    if(dirty & TYPED_VOL_D)
+        updateTypedVolume();
+    if(dirty & P_VOL_D)
+        updatepVolume();
+    if(dirty & OFFSETS_D)
+        updateOffsets();
+    if(dirty & DEADLINES_D)
+        updateDeadlines();
+}
+
+// 获取拓扑序: 已排序时直接返回ordIDs, 否则用Kahn算法在tmp中计算
+// 按任意拓扑序计算的偏移量与截止时间结果相同
+const std::vector<int>& DAGTask::topologicalOrder(std::vector<int>& tmp) const{
+    if(ordIDs.size())
+        return ordIDs;
+    if(!getCSR().kahnOrder(tmp))
+        FatalError("The graph contains a cycle, can't compute the topological order!");
+    return tmp;
+}
+
+// 计算所有顶点的本地偏移量(最早开始时间), 不修改顶点
+// localO: 输出, 按顶点索引排列
+void DAGTask::computeLocalOffsets(std::vector<Time_t>& localO) const{
+    std::vector<int> tmp;
+    const std::vector<int>& ord = topologicalOrder(tmp);
+
+    // 最早开始时间 = max(前驱的最早开始时间 + 其执行时间), 无前驱时为0
+    const CSRGraph& g = getCSR();
+    localO.assign(g.size(), -1);
+    Time_t local_o, temp_local_o;
+    for(const auto i: ord){
+        local_o = 0;
+        for(const int *p = g.predBegin(i); p != g.predEnd(i); ++p){
+            temp_local_o = localO[*p] + g.c[*p];
+            if(temp_local_o > local_o) local_o = temp_local_o;
+        }
+        localO[i] = local_o;
+    }
+}
+
+// 计算所有顶点的本地截止时间(最晚完成时间), 不修改顶点
+// localD: 输出, 按顶点索引排列
+void DAGTask::computeLocalDeadlines(std::vector<Time_t>& localD) const{
+    std::vector<int> tmp;
+    const std::vector<int>& ord = topologicalOrder(tmp);
+
+    // 最晚完成时间 = min(后继的最晚完成时间 - 其执行时间), 无后继时为任务截止时间
+    const CSRGraph& g = getCSR();
+    localD.assign(g.size(), -1);
+    Time_t local_d, temp_local_d;
+    for(int idx=ord.size()-1, i; idx>=0; --idx){
+        i = ord[idx];
+        if(g.outDegree(i) == 0)
+            local_d = d;
+        else{
+            local_d = 99999;
+            for(const int *s = g.succBegin(i); s != g.succEnd(i); ++s){
+                temp_local_d = localD[*s] - g.c[*s];
+                if(temp_local_d < local_d) local_d = temp_local_d;
+            }
+        }
+        localD[i] = local_d;
+    }
+}
+
+// 计算所有顶点的最早完成时间, 不修改顶点
+void DAGTask::computeEFTs(std::vector<Time_t>& localO, std::vector<Time_t>& EFT) const{
+    computeLocalOffsets(localO);
+
+    const CSRGraph& g = getCSR();
+    EFT.resize(g.size());
+    for(int i=0; i<g.size(); ++i)
+        EFT[i] = localO[i] + g.c[i];
+}
+
+// 计算所有顶点的最晚开始时间, 不修改顶点
+void DAGTask::computeLSTs(std::vector<Time_t>& localD, std::vector<Time_t>& LST) const{
+    computeLocalDeadlines(localD);
+
+    const CSRGraph& g = getCSR();
+    LST.resize(g.size());
+    for(int i=0; i<g.size(); ++i)
+        LST[i] = localD[i] - g.c[i];
 }
 
 // 计算所有顶点的本地偏移量(最早开始时间)
@@ -287,9 +619,10 @@ void DAGTask::computeLocalOffsets(){
     if(!ordIDs.size())
         topologicalSort();
 
-    for(int i=0; i<ordIDs.size();++i){
-        V[ordIDs[i]]->localOffset();
-    }
+    std::vector<Time_t> local_o;
+    computeLocalOffsets(local_o);
+    for(int i=0; i<V.size(); ++i)
+        V[i]->localO = local_o[i];
 }
 
 // 计算所有顶点的本地截止时间(最晚完成时间)
@@ -297,59 +630,48 @@ void DAGTask::computeLocalDeadlines(){
     if(!ordIDs.size())
         topologicalSort();
 
-    for(int i=ordIDs.size()-1; i>=0;--i){
-        V[ordIDs[i]]->localDeadline(d);
-    }
+    std::vector<Time_t> local_d;
+    computeLocalDeadlines(local_d);
+    for(int i=0; i<V.size(); ++i)
+        V[i]->localD = local_d[i];
 }
 
 // 计算所有顶点的最早完成时间
 void DAGTask::computeEFTs(){
-    DAGTask::computeLocalOffsets();
+    if(!ordIDs.size())
+        topologicalSort();
 
-    for(auto&v:V)
-        v->EasliestFinishingTime();
+    std::vector<Time_t> local_o, eft;
+    computeEFTs(local_o, eft);
+    for(int i=0; i<V.size(); ++i){
+        V[i]->localO = local_o[i];
+        V[i]->EFT = eft[i];
+    }
 }
 
 // 计算所有顶点的最晚开始时间
 void DAGTask::computeLSTs(){
-    DAGTask::computeLocalDeadlines();
-
-    for(auto&v:V)
-        v->LatestStartingTime();
-}
-
-// 递归计算从指定路径开始的所有路径
-// path: 当前路径
-// all_paths: 所有路径集合
-// 返回: 更新后的所有路径集合
-std::vector<std::vector<int>> DAGTask::computeAllPathsSingleSource(std::vector<int>& path, std::vector<std::vector<int>>& all_paths) const{
-    int last_node = path.back();
-    if(V[last_node]->succ.size() > 0) {
-        // 递归处理每个后继
-        for(int i=0; i<V[last_node]->succ.size(); ++i){
-            std::vector<int> new_path = path;
-            new_path.push_back(V[last_node]->succ[i]->id);
-            all_paths = computeAllPathsSingleSource(new_path, all_paths);
-        }
-    }
-    else
-        all_paths.push_back(path);  // 无后继则保存当前路径
+    if(!ordIDs.size())
+        topologicalSort();
 
-    return all_paths;
+    std::vector<Time_t> local_d, lst;
+    computeLSTs(local_d, lst);
+    for(int i=0; i<V.size(); ++i){
+        V[i]->localD = local_d[i];
+        V[i]->LST = lst[i];
+    }
 }
 
 // 计算DAG中的所有路径
-// 返回: 所有路径集合
+// 返回: 所有路径集合, 预先按路径数量分配
+// 路径数量可能远超可分配的大小(countPaths返回double), 预分配的数量有上限, 超出时按需增长
 std::vector<std::vector<int>> DAGTask::computeAllPaths() const{
+    const double max_reserved_paths = 1 << 16;
     std::vector<std::vector<int>> all_paths;
-    // 从每个无前驱的顶点开始
-    for(int i=0; i<V.size();++i){
-        if(V[i]->pred.size() == 0){
-            std::vector<int> cur_path;
-            cur_path.push_back(i);
-            all_paths = computeAllPathsSingleSource(cur_path, all_paths);
-        }
-    }
+    all_paths.reserve((size_t) std::min(countPaths(), max_reserved_paths));
+    PathEnumerator paths(getCSR());
+    while(paths.next())
+        all_paths.push_back(paths.path());
     return all_paths;
 }
 
@@ -5,9 +5,11 @@ namespace dagSched{
 // 为所有子任务分配随机的最坏执行时间(WCET)
 // minC: 最小执行时间
 // maxC: 最大执行时间
-void DAGTask::assignWCET(const int minC, const int maxC){
+// rng: 任务集的随机数流
+void DAGTask::assignWCET(const int minC, const int maxC, RandomStream& rng){
     for(auto &v: V)
-        v->c = intRandMaxMin(minC, maxC);  // 在[minC, maxC]范围内随机分配
+        v->c = rng.intRandMaxMin(minC, maxC);  // 在[minC, maxC]范围内随机分配
+    invalidateWCET();
 }
 
 // 递归扩展串并行任务结构
@@ -17,15 +19,16 @@ void DAGTask::assignWCET(const int minC, const int maxC){
 // numBranches: 分支数量
 // ifCond: 是否为条件分支
 // gp: 生成参数引用
-void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int depth,const int numBranches, const bool ifCond, GeneratorParams& gp){
+// rng: 任务集的随机数流
+void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int depth,const int numBranches, const bool ifCond, const GeneratorParams& gp, RandomStream& rng){
     // 计算水平空间分配因子
     int depthFactor = std::max(gp.maxCondBranches, gp.maxParBranches);
     int horSpace = std::pow(depthFactor,depth);
 
     // 初始情况：创建源节点和汇节点
     if(source == nullptr && sink==nullptr){
-        SubTask *so = new SubTask; // 源节点
-        SubTask *si = new SubTask; // 汇节点
+        SubTask *so = createSubTask(); // 源节点
+        SubTask *si = createSubTask(); // 汇节点
         so->depth = depth;
         si->depth = -depth;
         so->width = 0;
@@ -36,14 +39,14 @@ void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int d
         V.push_back(si);
 
         // 随机决定是创建条件分支还是并行分支
-        double r = ((double) rand() / (RAND_MAX));
+        double r = rng.uniform();
         if (r < gp.probSCond){ // 创建条件分支
-            int cond_branches = intRandMaxMin(2, gp.maxCondBranches);
-            expandTaskSeriesParallel(V[0], V[1], depth - 1, cond_branches, true, gp);
+            int cond_branches = rng.intRandMaxMin(2, gp.maxCondBranches);
+            expandTaskSeriesParallel(V[0], V[1], depth - 1, cond_branches, true, gp, rng);
         }
         else{ // 创建并行分支
-            int par_branches = intRandMaxMin(2, gp.maxParBranches);
-            expandTaskSeriesParallel(V[0], V[1], depth - 1, par_branches, false, gp);
+            int par_branches = rng.intRandMaxMin(2, gp.maxParBranches);
+            expandTaskSeriesParallel(V[0], V[1], depth - 1, par_branches, false, gp, rng);
         }
     }
     else{
@@ -55,14 +58,12 @@ void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int d
         // 为每个分支创建子任务
         for(int i=0; i<numBranches; ++i){
             creationStates state = TERMINAL_T;
-            if (depth != 0) state = static_cast<creationStates>(gp.dist(gp.gen));
+            if (depth != 0) state = static_cast<creationStates>(rng.discrete(gp.weights));
 
             switch (state){
             case TERMINAL_T:{ // 终止节点
-                SubTask *v = new SubTask;
+                SubTask *v = createSubTask();
                 v->id = V.size();
-                v->pred.push_back(source);
-                v->succ.push_back(sink);
                 v->mode = ifCond? C_INTERN_T : NORMAL_T;
                 v->depth = depth;
                 v->width = w1 + step * (i - 1);
@@ -72,39 +73,37 @@ void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int d
                 // 设置源节点和汇节点类型
                 source->mode = ifCond ? C_SOURCE_T : NORMAL_T;
                 sink->mode = ifCond ? C_SINK_T : NORMAL_T;
-                source->succ.push_back(V[V.size()-1]);
-                sink->pred.push_back(V[V.size()-1]);
+                addEdge(source, V[V.size()-1]);
+                addEdge(V[V.size()-1], sink);
                 break;
             }
             case PARALLEL_T: case CONDITIONAL_T:{
-                SubTask *v1 = new SubTask;
+                SubTask *v1 = createSubTask();
                 v1->id = V.size();
-                v1->pred.push_back(source);
                 v1->mode = ifCond? C_INTERN_T : NORMAL_T;
                 v1->depth = depth;
                 v1->width = w1 + step * (i - 1);
                 V.push_back(v1);
 
-                source->succ.push_back(V[V.size()-1]);
+                addEdge(source, V[V.size()-1]);
                 source->mode = ifCond ? C_SOURCE_T : NORMAL_T;
 
-                SubTask *v2 = new SubTask;
+                SubTask *v2 = createSubTask();
                 v2->id = V.size();
-                v2->succ.push_back(sink);
                 v2->mode = ifCond? C_INTERN_T : NORMAL_T;
                 v2->depth = -depth;
                 v2->width = w2 + step * (i - 1);
                 V.push_back(v2);
 
-                sink->pred.push_back(V[V.size()-1]);
+                addEdge(V[V.size()-1], sink);
                 sink->mode = ifCond ? C_SINK_T : NORMAL_T;
 
                 int max_branches = (state == PARALLEL_T )? gp.maxParBranches : gp.maxCondBranches;
                 float cond = (state == PARALLEL_T) ? false: true;
 
-                int branches = intRandMaxMin(2, max_branches);
+                int branches = rng.intRandMaxMin(2, max_branches);
             
-                expandTaskSeriesParallel(V[V.size()-2], V[V.size()-1], depth - 1, branches, cond, gp);
+                expandTaskSeriesParallel(V[V.size()-2], V[V.size()-1], depth - 1, branches, cond, gp, rng);
             
                 break;
             }
@@ -114,11 +113,15 @@ void DAGTask::expandTaskSeriesParallel(SubTask* source,SubTask* sink,const int d
             }
         }
     }
+    invalidateGraph();
 }
 
 // 为DAG添加额外边使其成为真正的有向无环图
 // prob: 添加边的概率
-void DAGTask::makeItDag(float prob){
+// rng: 任务集的随机数流
+// 在本地可达性矩阵上增量维护已添加的边, 避免每次查询都重新遍历图
+void DAGTask::makeItDag(float prob, RandomStream& rng){
+    ReachabilityMatrix closure(getCSR());
     bool is_already_succ= false;
     std::vector<int> v_cond_pred;
     std::vector<int> w_cond_pred;
@@ -127,48 +130,51 @@ void DAGTask::makeItDag(float prob){
 
         for(auto &w:V){
             w_cond_pred = w->getCondPred();
-            is_already_succ = false;
-
-            isSuccessor(w, v, is_already_succ);
+            is_already_succ = closure.reaches(v->id, w->id);
 
             if( v->depth > w->depth &&
                 v->mode != C_SOURCE_T &&
                 !is_already_succ &&
                 w_cond_pred.size() == v_cond_pred.size() && 
                 std::equal(v_cond_pred.begin(), v_cond_pred.end(), w_cond_pred.begin()) && 
-                ((double) rand() / (RAND_MAX)) < prob
+                rng.uniform() < prob
             )
             {
                 // 添加边 v -> w
-                v->succ.push_back(w);
-                w->pred.push_back(v);
+                addEdge(v, w);
+                closure.addEdge(v->id, w->id);
             }
         }
     }
+    invalidateGraph();
 }
 
 // 使用UUniFast算法分配调度参数
 // U: 目标利用率
 void DAGTask::assignSchedParametersUUniFast(const float U){
-    t = std::ceil(wcw / U);
+    t = std::ceil(getWCW() / U);
     d = t;    
+    dirty |= DEADLINES_D;
 }
 
 // 随机分配调度参数
 // beta: 参数beta
-void DAGTask::assignSchedParameters(const float beta){
-    float Tmin = L;
-    float Tmax = wcw / beta;
-    t = floatRandMaxMin(Tmin, Tmax);
-    d = floatRandMaxMin(Tmin, t);
+// rng: 任务集的随机数流
+void DAGTask::assignSchedParameters(const float beta, RandomStream& rng){
+    float Tmin = getLength();
+    float Tmax = getWCW() / beta;
+    t = toTimeDown(rng.floatRandMaxMin(Tmin, Tmax));
+    d = toTimeDown(rng.floatRandMaxMin(Tmin, t));
+    dirty |= DEADLINES_D;
 }
 
 // 分配固定调度参数
 // period: 周期
 // deadline: 截止时间
-void DAGTask::assignFixedSchedParameters(const float period, const float deadline){
+void DAGTask::assignFixedSchedParameters(const Time_t period, const Time_t deadline){
     t = period;
     d = deadline;
+    dirty |= DEADLINES_D;
 }
 
 }
\ No newline at end of file
@@ -9,11 +9,11 @@ std::ostream& operator<<(std::ostream& os, const DAGTask& t)
     os<<"----------------------------------------------------\n";
     os<< "deadline :" << t.d <<std::endl;  // 截止时间
     os<< "period :" << t.t <<std::endl;    // 周期
-    os<< "length :" << t.L <<std::endl;    // 最长链长度
-    os<< "volume :" << t.vol <<std::endl;  // 总体积
-    os<< "wcw :" << t.wcw <<std::endl;     // 最坏情况工作负载
-    os<< "utilization :" << t.u <<std::endl; // 利用率
-    os<< "density :" << t.delta <<std::endl; // 密度
+    os<< "length :" << t.getLength() <<std::endl;    // 最长链长度
+    os<< "volume :" << t.getVolume() <<std::endl;  // 总体积
+    os<< "wcw :" << t.getWCW() <<std::endl;     // 最坏情况工作负载
+    os<< "utilization :" << t.getUtilization() <<std::endl; // 利用率
+    os<< "density :" << t.getDensity() <<std::endl; // 密度
     
     // 打印所有顶点信息
     os<< "vertices :"<<std::endl;
@@ -57,7 +57,7 @@ void DAGTask::readTaskFromYamlNode(YAML::Node tasks, const int i){
     std::map<int, int> id_pos;  // 映射原始ID到位置索引
 
     for(int j=0; j<vert.size(); j++){
-        SubTask *v = new SubTask;
+        SubTask *v = createSubTask();
         v->id = j;  // 使用连续编号作为新ID
         v->c = vert[j]["c"].as<int>();  // 读取WCET
 
@@ -82,9 +82,9 @@ void DAGTask::readTaskFromYamlNode(YAML::Node tasks, const int i){
         to_id = id_pos[edges[j]["to"].as<int>()];
 
         // 建立前驱后继关系
-        V[form_id]->succ.push_back(V[to_id]);
-        V[to_id]->pred.push_back(V[form_id]);
+        addEdge(V[form_id], V[to_id]);
     }
+    invalidateGraph();
 }
 
 // 从DOT文件读取任务信息
@@ -106,7 +106,7 @@ void DAGTask::readTaskFromDOT(const std::string &filename){
         }
         else if (di.lineType == DOTLine_t::DOT_NODE){
             // 处理顶点信息
-            SubTask *v = new SubTask;
+            SubTask *v = createSubTask();
             v->id = node_count;
             v->c = di.wcet;
             id_pos[di.id] = node_count;  // 建立ID映射
@@ -126,11 +126,11 @@ void DAGTask::readTaskFromDOT(const std::string &filename){
             to_id = id_pos[di.id_to];
 
             // 建立前驱后继关系
-            V[form_id]->succ.push_back(V[to_id]);
-            V[to_id]->pred.push_back(V[form_id]);
+            addEdge(V[form_id], V[to_id]);
         }
     }
     dot_dag.close();
+    invalidateGraph();
 }
 
 // 将任务保存为DOT格式
@@ -0,0 +1,81 @@
+#include "dagSched/EvalCheckpoint.h"
+#include "dagSched/utils.h"
+
+#include <fstream>
+#include <cstdio>
+#include <yaml-cpp/yaml.h>
+
+namespace dagSched{
+
+void EvalProgress::markDone(const int i){
+    if(i < doneBelow)
+        return;
+    doneAbove.insert(i);
+
+    // 前缀连续时并入前缀
+    while(!doneAbove.empty() && *doneAbove.begin() == doneBelow){
+        doneAbove.erase(doneAbove.begin());
+        ++doneBelow;
+    }
+}
+
+void EvalCheckpoint::save(const std::string& path) const{
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    out << YAML::Key << "configHash" << YAML::Value << configHash;
+    out << YAML::Key << "seed" << YAML::Value << seed;
+    out << YAML::Key << "nTasksets" << YAML::Value << nTasksets;
+    out << YAML::Key << "resultsSize" << YAML::Value << resultsSize;
+    out << YAML::Key << "doneBelow" << YAML::Value << progress.doneBelow;
+    out << YAML::Key << "doneAbove" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+    for(const int i: progress.doneAbove)
+        out << i;
+    out << YAML::EndSeq;
+    out << YAML::EndMap;
+
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream f(tmp_path);
+    if(!f.is_open())
+        FatalError("Can't write the checkpoint " + tmp_path);
+    f << out.c_str() << "\n";
+    f.close();
+
+    if(std::rename(tmp_path.c_str(), path.c_str()) != 0)
+        FatalError("Can't write the checkpoint " + path);
+}
+
+bool EvalCheckpoint::load(const std::string& path){
+    std::ifstream f(path);
+    if(!f.is_open())
+        return false;
+    f.close();
+
+    YAML::Node config = YAML::LoadFile(path);
+    configHash = config["configHash"].as<uint64_t>();
+    seed = config["seed"].as<uint64_t>();
+    nTasksets = config["nTasksets"].as<int>();
+    resultsSize = config["resultsSize"].as<uint64_t>();
+
+    progress = EvalProgress();
+    progress.doneBelow = config["doneBelow"].as<int>();
+    for(size_t i=0; i<config["doneAbove"].size(); ++i)
+        progress.doneAbove.insert(config["doneAbove"][i].as<int>());
+
+    return true;
+}
+
+uint64_t hashFileContent(const std::string& path){
+    std::ifstream f(path, std::ios::binary);
+    if(!f.is_open())
+        FatalError("Can't open " + path);
+
+    uint64_t h = 0xcbf29ce484222325ULL;
+    char c;
+    while(f.get(c)){
+        h ^= (unsigned char) c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+}
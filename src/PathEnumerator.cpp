@@ -0,0 +1,67 @@
+#include "dagSched/PathEnumerator.h"
+
+namespace dagSched{
+
+// 从当前路径的末端开始, 每层选择第一个后继, 直到到达汇点
+bool PathEnumerator::descend(){
+    int v = cur.back();
+    while(g.outDegree(v) > 0){
+        const int e = g.succOffset[v];
+        edge.push_back(e + 1);
+        v = g.succIdx[e];
+        cur.push_back(v);
+    }
+    return true;
+}
+
+// 前进到下一条路径
+// 回溯到最近一个仍有未访问后继的顶点并从该后继继续向下; 栈为空时从下一个源点开始
+bool PathEnumerator::next(){
+    if(started && !cur.empty()){
+        // 弹出汇点, 其下没有待访问的后继
+        cur.pop_back();
+        while(!cur.empty()){
+            const int k = cur.size() - 1;
+            if(edge[k] < g.succOffset[cur[k] + 1]){
+                cur.push_back(g.succIdx[edge[k]++]);
+                return descend();
+            }
+            cur.pop_back();
+            edge.pop_back();
+        }
+    }
+    started = true;
+
+    while(nextSource < g.size() && g.inDegree(nextSource) > 0)
+        ++nextSource;
+    if(nextSource == g.size())
+        return false;
+
+    cur.push_back(nextSource++);
+    return descend();
+}
+
+// 计算路径总数
+// 按逆拓扑序计算从每个顶点出发到汇点的路径数, 再对所有源点求和
+double PathEnumerator::count(const CSRGraph& g){
+    std::vector<int> order;
+    if(!g.kahnOrder(order))
+        FatalError("The graph contains a cycle, can't count its paths!");
+
+    std::vector<double> n_paths(g.size(), 0);
+    double total = 0;
+    for(int k=order.size()-1; k>=0; --k){
+        const int v = order[k];
+        if(g.outDegree(v) == 0)
+            n_paths[v] = 1;
+        else
+            for(const int* s = g.succBegin(v); s != g.succEnd(v); ++s)
+                n_paths[v] += n_paths[*s];
+
+        if(g.inDegree(v) == 0)
+            total += n_paths[v];
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,193 @@
+#include "dagSched/PerfCounters.h"
+#include "dagSched/utils.h"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace dagSched{
+
+const char* perfEventName(const PerfEvent_t e){
+    switch (e){
+    case PerfEvent_t::CYCLES:
+        return "cycles";
+    case PerfEvent_t::INSTRUCTIONS:
+        return "instructions";
+    case PerfEvent_t::CACHE_MISSES:
+        return "cache_misses";
+    case PerfEvent_t::BRANCH_MISSES:
+        return "branch_misses";
+    case PerfEvent_t::PAGE_FAULTS:
+        return "page_faults";
+    default:
+        break;
+    }
+    return "";
+}
+
+#ifdef __linux__
+
+namespace{
+
+int openCounter(const uint32_t type, const uint64_t config){
+    perf_event_attr attr {};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // pid = 0, cpu = -1: 调用线程, 在任意处理器上
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+}
+
+PerfCounters::PerfCounters(){
+    fd[PerfEvent_t::CYCLES]         = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fd[PerfEvent_t::INSTRUCTIONS]   = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fd[PerfEvent_t::CACHE_MISSES]   = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fd[PerfEvent_t::BRANCH_MISSES]  = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fd[PerfEvent_t::PAGE_FAULTS]    = openCounter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+}
+
+PerfCounters::~PerfCounters(){
+    for(const int f: fd)
+        if(f >= 0)
+            close(f);
+}
+
+void PerfCounters::start(){
+    for(const int f: fd)
+        if(f >= 0){
+            ioctl(f, PERF_EVENT_IOC_RESET, 0);
+            ioctl(f, PERF_EVENT_IOC_ENABLE, 0);
+        }
+}
+
+perfSample PerfCounters::stop(){
+    perfSample s;
+    for(int e=0; e<N_PERF_EVENTS; ++e){
+        if(fd[e] < 0)
+            continue;
+        ioctl(fd[e], PERF_EVENT_IOC_DISABLE, 0);
+
+        // value, time_enabled, time_running
+        uint64_t data[3] = {0, 0, 0};
+        if(read(fd[e], data, sizeof(data)) != sizeof(data))
+            continue;
+
+        // 计数器被复用时按实际计数的时间比例放大
+        if(data[2] > 0 && data[2] < data[1])
+            data[0] = (uint64_t)((double)data[0] * data[1] / data[2]);
+        s.value[e] = data[0];
+        s.valid[e] = true;
+    }
+    return s;
+}
+
+#else
+
+PerfCounters::PerfCounters(){
+    fd.fill(-1);
+}
+
+PerfCounters::~PerfCounters(){}
+
+void PerfCounters::start(){}
+
+perfSample PerfCounters::stop(){
+    return perfSample();
+}
+
+#endif
+
+bool PerfCounters::available() const{
+    for(const int f: fd)
+        if(f >= 0)
+            return true;
+    return false;
+}
+
+PerfCounters& PerfCounters::threadCounters(){
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+void PerfAggregator::add(const std::string& name, const perfSample& sample){
+    std::lock_guard<std::mutex> lock(mtx);
+    perfStats& s = stats[name];
+    s.calls++;
+    for(int e=0; e<N_PERF_EVENTS; ++e)
+        if(sample.valid[e]){
+            s.sum[e] += sample.value[e];
+            s.validCalls[e]++;
+        }
+}
+
+std::map<std::string, perfStats> PerfAggregator::getStats() const{
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+
+void PerfAggregator::print(std::ostream& os) const{
+    const std::map<std::string, perfStats> s = getStats();
+
+    auto mean = [](const perfStats& st, const int e) -> double {
+        return st.validCalls[e] ? (double) st.sum[e] / st.validCalls[e] : -1;
+    };
+    auto ratio = [](const perfStats& st, const int num, const int den, const double scale) -> double {
+        return st.validCalls[num] && st.validCalls[den] && st.sum[den] ? scale * st.sum[num] / st.sum[den] : -1;
+    };
+
+    os<<"performance counters (mean per call, -1 if not available)"<<std::endl;
+    for(const auto& st: s){
+        os<<st.first<<" calls: "<<st.second.calls;
+        for(int e=0; e<N_PERF_EVENTS; ++e)
+            os<<" "<<perfEventName((PerfEvent_t) e)<<": "<<mean(st.second, e);
+        os<<" IPC: "<<ratio(st.second, PerfEvent_t::INSTRUCTIONS, PerfEvent_t::CYCLES, 1);
+        os<<" cache_MPKI: "<<ratio(st.second, PerfEvent_t::CACHE_MISSES, PerfEvent_t::INSTRUCTIONS, 1000);
+        os<<" branch_MPKI: "<<ratio(st.second, PerfEvent_t::BRANCH_MISSES, PerfEvent_t::INSTRUCTIONS, 1000);
+        os<<std::endl;
+    }
+}
+
+void PerfAggregator::save(const std::string& path) const{
+    std::ofstream out(path);
+    if(!out.is_open())
+        FatalError("Can't open the performance counter file " + path);
+
+    out<<"test,calls";
+    for(int e=0; e<N_PERF_EVENTS; ++e)
+        out<<","<<perfEventName((PerfEvent_t) e);
+    out<<"\n";
+
+    for(const auto& st: getStats()){
+        out<<st.first<<","<<st.second.calls;
+        for(int e=0; e<N_PERF_EVENTS; ++e){
+            out<<",";
+            if(st.second.validCalls[e])
+                out<<st.second.sum[e];
+        }
+        out<<"\n";
+    }
+}
+
+PerfScope::PerfScope(PerfAggregator* aggregator, const std::string& name): aggregator(aggregator), name(name){
+    if(aggregator)
+        PerfCounters::threadCounters().start();
+}
+
+PerfScope::~PerfScope(){
+    if(aggregator)
+        aggregator->add(name, PerfCounters::threadCounters().stop());
+}
+
+}
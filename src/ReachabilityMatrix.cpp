@@ -0,0 +1,123 @@
+#include "dagSched/ReachabilityMatrix.h"
+#include <algorithm>
+
+namespace dagSched{
+
+// 从CSR图计算传递闭包
+// 先用Kahn算法求拓扑序, 再按逆拓扑序合并后继的后代行、按拓扑序合并前驱的祖先行
+// 计算后代行时按拓扑位置递增访问后继: 若某后继已被之前后继的后代覆盖,
+// 则边u->s为传递边, 其后代也已包含在内, 无需再合并
+void ReachabilityMatrix::build(const CSRGraph& g, std::vector<char>* redundant){
+    n = g.size();
+    words = bitsetWords(n);
+    desc.assign((size_t)n * words, 0);
+    ancst.assign((size_t)n * words, 0);
+    if(redundant)
+        redundant->assign(g.succIdx.size(), 0);
+
+    // Kahn拓扑排序
+    std::vector<int> order;
+    if(!g.kahnOrder(order))
+        FatalError("The graph contains a cycle, can't compute the reachability matrix!");
+
+    std::vector<int> pos(n);
+    for(int k=0; k<n; ++k)
+        pos[order[k]] = k;
+
+    // 后代: desc[u] = ∪(desc[s] ∪ {s}), s为u的后继
+    std::vector<int> succ_slots;
+    for(int k=n-1; k>=0; --k){
+        const int u = order[k];
+        bitword_t* row = desc.data() + (size_t)u * words;
+
+        succ_slots.clear();
+        for(int e = g.succOffset[u]; e < g.succOffset[u+1]; ++e)
+            succ_slots.push_back(e);
+        std::sort(succ_slots.begin(), succ_slots.end(), [&](const int a, const int b){
+            return pos[g.succIdx[a]] < pos[g.succIdx[b]];
+        });
+
+        for(const int e: succ_slots){
+            const int s = g.succIdx[e];
+            if(bitsetTest(row, s)){
+                if(redundant)
+                    (*redundant)[e] = 1;
+            }
+            else
+                bitsetOr(row, descendants(s), words);
+        }
+        for(const int e: succ_slots)
+            bitsetSet(row, g.succIdx[e]);
+    }
+
+    // 祖先: ancst[v] = ∪(ancst[p] ∪ {p}), p为v的前驱
+    for(int k=0; k<n; ++k){
+        const int v = order[k];
+        bitword_t* row = ancst.data() + (size_t)v * words;
+        for(const int* p = g.predBegin(v); p != g.predEnd(v); ++p){
+            bitsetOr(row, ancestors(*p), words);
+            bitsetSet(row, *p);
+        }
+    }
+}
+
+// 增量添加边u->v
+// u及其所有祖先获得v及其后代, v及其所有后代获得u及其祖先
+void ReachabilityMatrix::addEdge(const int u, const int v){
+    if(reaches(u, v))
+        return;
+    if(u == v || reaches(v, u))
+        FatalError("Adding this edge would create a cycle!");
+
+    std::vector<bitword_t> new_desc(descendants(v), descendants(v) + words);
+    bitsetSet(new_desc.data(), v);
+    std::vector<bitword_t> new_ancst(ancestors(u), ancestors(u) + words);
+    bitsetSet(new_ancst.data(), u);
+
+    bitsetForEach(new_ancst.data(), words, [&](const int a){
+        bitsetOr(desc.data() + (size_t)a * words, new_desc.data(), words);
+    });
+    bitsetForEach(new_desc.data(), words, [&](const int d){
+        bitsetOr(ancst.data() + (size_t)d * words, new_ancst.data(), words);
+    });
+}
+
+// 增量删除边u->v
+// 经过该边的路径都从u或其祖先出发、到达v或其后代, 只有这些行可能改变;
+// 删除出边不改变u的祖先, 删除入边不改变v的后代, 因此受影响的顶点集合可由删除前的闭包得到。
+// 在DAG中x可达y时x的后代严格多于y的后代, 按删除前的后代数量升序即为逆拓扑序(祖先同理),
+// 按此顺序由后继(前驱)的行重新合并, 用到的行都已是删除后的结果。
+void ReachabilityMatrix::removeEdge(const int u, const int v, const std::vector<SubTask*>& V){
+    std::vector<int> sources, sinks;
+    bitsetForEach(ancestors(u), words, [&](const int a){ sources.push_back(a); });
+    sources.push_back(u);
+    bitsetForEach(descendants(v), words, [&](const int d){ sinks.push_back(d); });
+    sinks.push_back(v);
+
+    std::vector<int> count(n);
+    for(const int x: sources)
+        count[x] = countDescendants(x);
+    std::sort(sources.begin(), sources.end(), [&](const int a, const int b){ return count[a] < count[b]; });
+    for(const int y: sinks)
+        count[y] = countAncestors(y);
+    std::sort(sinks.begin(), sinks.end(), [&](const int a, const int b){ return count[a] < count[b]; });
+
+    for(const int x: sources){
+        bitword_t* row = desc.data() + (size_t)x * words;
+        std::fill(row, row + words, 0);
+        for(const auto s: V[x]->succ){
+            bitsetOr(row, descendants(s->id), words);
+            bitsetSet(row, s->id);
+        }
+    }
+    for(const int y: sinks){
+        bitword_t* row = ancst.data() + (size_t)y * words;
+        std::fill(row, row + words, 0);
+        for(const auto p: V[y]->pred){
+            bitsetOr(row, ancestors(p->id), words);
+            bitsetSet(row, p->id);
+        }
+    }
+}
+
+}
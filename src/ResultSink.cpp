@@ -0,0 +1,237 @@
+#include "dagSched/ResultSink.h"
+#include "dagSched/utils.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/AllocAccounting.h"
+
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace dagSched{
+
+ResultSink::ResultSink(const std::string& path, const std::string& x_label, const bool append, const size_t buffer_size): bufferSize(buffer_size){
+    if(append){
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        if(!existing.is_open())
+            FatalError("Can't append to the result file " + path);
+        written = existing.tellg();
+        submitted = written;
+        existing.close();
+
+        out.open(path, std::ios::binary | std::ios::app);
+        if(!out.is_open())
+            FatalError("Can't append to the result file " + path);
+    }
+    else{
+        out.open(path, std::ios::binary);
+        if(!out.is_open())
+            FatalError("Can't open the result file " + path);
+
+        std::stringstream header;
+        header<<"# x: "<<x_label<<"\n";
+        header<<"taskset,point,x,m,n_tasks,U,test,sched,time,allocations,bytes,peak_bytes\n";
+        out<<header.str();
+        written = header.str().size();
+        submitted = written;
+    }
+
+    buffer.reserve(bufferSize);
+    writer = std::thread(&ResultSink::writerLoop, this);
+}
+
+ResultSink::~ResultSink(){
+    close();
+}
+
+// 后台线程: 等待写满的缓冲区并写入磁盘, 关闭时写完剩余的缓冲区后退出
+void ResultSink::writerLoop(){
+    std::vector<std::string> to_write;
+    uint64_t n_bytes = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            written += n_bytes;
+            writing = false;
+            drained.notify_all();
+
+            cv.wait(lock, [this]{ return closing || !full.empty(); });
+            to_write.swap(full);
+            if(to_write.empty() && closing)
+                break;
+            writing = true;
+        }
+
+        n_bytes = 0;
+        for(const auto& b: to_write){
+            out.write(b.data(), b.size());
+            n_bytes += b.size();
+        }
+        out.flush();
+        to_write.clear();
+    }
+}
+
+void ResultSink::write(const std::vector<resultRow>& rows){
+    // 在锁外格式化, float和double分别用9位和17位有效数字, 读回时与原值完全相同
+    std::string lines;
+    char num[128];
+    const bool accounting = allocAccountingEnabled();
+    for(const auto& r: rows){
+        int n = snprintf(num, sizeof(num), "%d,%d,%.9g,%d,%d,%.9g,", r.taskset, r.point, r.x, r.m, r.n_tasks, r.U);
+        lines.append(num, n);
+        lines += r.test;
+        n = snprintf(num, sizeof(num), ",%d,%.17g", r.sched, r.time);
+        lines.append(num, n);
+        if(accounting)
+            n = snprintf(num, sizeof(num), ",%llu,%llu,%llu\n", (unsigned long long) r.allocations, (unsigned long long) r.bytes, (unsigned long long) r.peakBytes);
+        else
+            n = snprintf(num, sizeof(num), ",,,\n");
+        lines.append(num, n);
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    buffer += lines;
+    submitted += lines.size();
+    if(buffer.size() >= bufferSize){
+        full.push_back(std::move(buffer));
+        buffer.clear();
+        buffer.reserve(bufferSize);
+        cv.notify_one();
+    }
+}
+
+uint64_t ResultSink::size(){
+    std::lock_guard<std::mutex> lock(mtx);
+    return submitted;
+}
+
+void ResultSink::flush(const uint64_t n){
+    std::unique_lock<std::mutex> lock(mtx);
+    if(closing)
+        return;
+
+    // 前n个字节还有一部分在正在填充的缓冲区中时, 将其交给后台线程
+    if(n > submitted - buffer.size() && !buffer.empty()){
+        full.push_back(std::move(buffer));
+        buffer.clear();
+        buffer.reserve(bufferSize);
+        cv.notify_one();
+    }
+    drained.wait(lock, [&]{ return written >= n; });
+}
+
+void ResultSink::close(){
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(closing)
+            return;
+        if(!buffer.empty())
+            full.push_back(std::move(buffer));
+        closing = true;
+    }
+    cv.notify_one();
+    writer.join();
+    out.close();
+}
+
+bool readResults(const std::string& path, evalResults& res){
+    std::ifstream in(path);
+    if(!in.is_open())
+        return false;
+
+    res = evalResults();
+
+    // (任务集索引, 耗时), 读完后按任务集排序
+    std::map<std::string,std::vector<std::pair<int,double>>> times;
+    std::map<std::string,std::vector<int>> sched;
+
+    const std::string label_prefix = "# x: ";
+    std::string line, field;
+    std::vector<std::string> fields;
+    while(std::getline(in, line)){
+        // 没有换行符结尾的最后一行是中断时写了一半的行, 字段数可能正好完整, 直接跳过
+        if(in.eof())
+            break;
+        if(line.compare(0, label_prefix.size(), label_prefix) == 0){
+            res.xLabel = line.substr(label_prefix.size());
+            continue;
+        }
+        if(line.empty() || line[0] == '#' || line.compare(0, 7, "taskset") == 0)
+            continue;
+
+        fields.clear();
+        std::stringstream ss(line);
+        while(std::getline(ss, field, ','))
+            fields.push_back(field);
+        // 旧的结果文件没有分配统计列; 分配统计为空时getline不会返回最后一个空字段
+        if(fields.size() < 9 || fields.size() > 12)
+            continue;
+
+        // 先解析所有数值字段, 格式错误的行整行跳过
+        int taskset, point, verdict;
+        float x;
+        double time;
+        uint64_t peak_bytes = 0;
+        const bool has_peak = fields.size() == 12 && !fields[11].empty();
+        try{
+            taskset = std::stoi(fields[0]);
+            point = std::stoi(fields[1]);
+            x = std::stof(fields[2]);
+            verdict = std::stoi(fields[7]);
+            time = std::stod(fields[8]);
+            if(has_peak)
+                peak_bytes = std::stoull(fields[11]);
+        }
+        catch(const std::exception&){
+            continue;
+        }
+        if(point < 0)
+            continue;
+
+        const std::string& test = fields[6];
+
+        if(res.x.size() <= point)
+            res.x.resize(point + 1, 0);
+        res.x[point] = x;
+
+        // 超时的任务集单独计数, 不计入可调度的任务集
+        std::vector<int>& s = sched[test];
+        if(s.size() <= point)
+            s.resize(point + 1, 0);
+        s[point] += verdict == Verdict_t::SCHEDULABLE;
+
+        if(verdict == Verdict_t::TIMED_OUT){
+            std::vector<int>& to = res.timedOut[test];
+            if(to.size() <= point)
+                to.resize(point + 1, 0);
+            to[point]++;
+        }
+
+        times[test].push_back(std::make_pair(taskset, time));
+
+        if(has_peak){
+            uint64_t& peak = res.peakBytes[test];
+            peak = std::max<uint64_t>(peak, peak_bytes);
+        }
+    }
+
+    for(const auto& s: sched)
+        res.sched[s.first] = std::vector<float>(s.second.begin(), s.second.end());
+    for(auto& s: res.sched)
+        s.second.resize(res.x.size(), 0);
+    for(auto& to: res.timedOut)
+        to.second.resize(res.x.size(), 0);
+
+    for(auto& t: times){
+        std::stable_sort(t.second.begin(), t.second.end(),
+            [](const std::pair<int,double>& a, const std::pair<int,double>& b){ return a.first < b.first; });
+        std::vector<double>& v = res.times[t.first];
+        for(const auto& it: t.second)
+            v.push_back(it.second);
+    }
+
+    return true;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "dagSched/SP-Tree.h"
+#include "dagSched/AnalysisBudget.h"
 
 namespace dagSched{
 
@@ -56,20 +57,15 @@ void SPTree::saveAsDot(SPNode *node,const std::string filename){
 std::vector<std::vector<int>> SPTree::computeJoinsForVertices(const DAGTask& dag){
     auto V = dag.getVertices();
     auto ordIDs = dag.getTopologicalOrder();
+    const CSRGraph& g = dag.getCSR();
+    const ReachabilityMatrix& reach = dag.getReachability();
     std::vector<std::vector<int>> J_nodes(V.size());
-    bool ok_join = false;
 
     for(int idx_1 = 0, i; idx_1 < ordIDs.size(); ++idx_1 ){
         i = ordIDs[idx_1];
-        if (V[i]->pred.size() > 1){ // join
-            for(int k=0; k< V.size(); ++k){
-                if (k != i){
-                    ok_join = false;
-                    dag.isSuccessor(V[i], V[k], ok_join);
-                    if(ok_join)
-                        J_nodes[k].push_back(i);
-                }
-            }
+        if (g.inDegree(i) > 1){ // join
+            // every ancestor of the join (in increasing index order) gets it
+            reach.forEachAncestor(i, [&](const int k){ J_nodes[k].push_back(i); });
             J_nodes[i].push_back(i);
         }
     }
@@ -77,24 +73,25 @@ std::vector<std::vector<int>> SPTree::computeJoinsForVertices(const DAGTask& dag
 }
 
 std::vector<STempNode> SPTree::computeInitialS(const DAGTask& dag){
-    auto V = dag.getVertices();
     auto ordIDs = dag.getTopologicalOrder();
+    const CSRGraph& g = dag.getCSR();
     std::vector<struct STempNode> S;
 
+    // position of each vertex in the topological order
+    std::vector<int> ord_pos(g.size(), -1);
+    for(int idx = 0; idx < ordIDs.size(); ++idx)
+        ord_pos[ordIDs[idx]] = idx;
+
+    S.reserve(g.succIdx.size());
     for(int idx_1 = 0, i; idx_1 < ordIDs.size(); ++idx_1 ){
         i = ordIDs[idx_1];
 
-        for(int j=0; j<V[i]->succ.size(); ++j){
+        for(const int *s = g.succBegin(i); s != g.succEnd(i); ++s){
             struct STempNode n;
             n.left = i;
-            n.right = V[i]->succ[j]->id;
+            n.right = *s;
             n.left_ordids = idx_1;
-            for(int idx_2 = 0; idx_2 < ordIDs.size(); ++idx_2 ){
-                if(V[ordIDs[idx_2]]->id == V[i]->succ[j]->id){
-                    n.right_ordids = idx_2;
-                    break;
-                }
-            }
+            n.right_ordids = ord_pos[*s];
             S.push_back(n);
         }
     }
@@ -515,13 +512,13 @@ void SPTree::convertNFJDAGtoSPTree(const DAGTask& dag, const int dag_id){
     root = subtrees[0];
 }
 
-std::vector<int> SPTree::computeP(  SPNode * node, const std::vector<SubTask*>& V){
+std::vector<int> SPTree::computeP(  SPNode * node, const std::vector<Time_t>& c){
 
     std::vector<int> par_ids_l, par_ids_r;
     if(node->left != nullptr)
-        par_ids_l = computeP(node->left, V);
+        par_ids_l = computeP(node->left, c);
     if(node->right != nullptr)
-        par_ids_r = computeP(node->right, V);
+        par_ids_r = computeP(node->right, c);
 
     if(node->type == NodeType_t::P){
         std::vector<int> par_ids;
@@ -537,7 +534,7 @@ std::vector<int> SPTree::computeP(  SPNode * node, const std::vector<SubTask*>&
     }
     else{       
         std::vector<int> par_ids;
-        if(V[node->V_id]->c > 0)
+        if(c[node->V_id] > 0)
             par_ids.push_back(node->V_id);
         return par_ids;
     }
@@ -547,20 +544,23 @@ std::vector<std::pair<float, float>> SPTree::computeWDUCO(const DAGTask& dag, co
 
     std::vector<std::pair<float, float>> WD_UCO_y;
 
-    auto V = dag.getVertices();
-    float width;
+    // remaining WCETs, consumed on a copy so that the DAG is left untouched
+    std::vector<Time_t> c = dag.getCSR().c;
+    Time_t width;
 
     while(true){
-        auto Ps = computeP(root, V);
+        if(budgetExhausted())
+            break;
+        auto Ps = computeP(root, c);
         if(Ps.size() == 0)
             break;
         
         // printVector<int>(Ps);
         
-        width = V[Ps[0]]->c;
+        width = c[Ps[0]];
         for(auto &p:Ps){
-            if(V[p]->c < width)
-                width = V[p]->c;
+            if(c[p] < width)
+                width = c[p];
         }
 
         // std::cout<<width << " "<< Ps.size()<<std::endl;
@@ -568,7 +568,7 @@ std::vector<std::pair<float, float>> SPTree::computeWDUCO(const DAGTask& dag, co
         WD_UCO_y.push_back(std::make_pair(width, Ps.size()));
 
         for(auto &p:Ps)
-            V[p]->c -= width;
+            c[p] -= width;
         
     }
 
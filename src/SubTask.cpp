@@ -20,7 +20,7 @@ void SubTask::localOffset(){
         localO = 0;
     else{
         localO = 0;
-        float temp_local_o = 0;
+        Time_t temp_local_o = 0;
         // 遍历所有前驱节点，计算最大(前驱节点的最早开始时间 + 其执行时间)
         for(int i=0; i<pred.size();++i){
             temp_local_o = pred[i]->localO + pred[i]->c;
@@ -38,13 +38,13 @@ void SubTask::EasliestFinishingTime(){
 }
 
 // 计算本地截止时间
-void SubTask::localDeadline(const float task_deadline){
+void SubTask::localDeadline(const Time_t task_deadline){
     if(succ.size() == 0)
         // 没有后继节点，使用任务全局截止时间
         localD = task_deadline;
     else{
         localD = 99999;  // 初始化为大数
-        float temp_local_d = 0;
+        Time_t temp_local_d = 0;
         // 遍历所有后继节点，计算最小(后继节点的本地截止时间 - 其执行时间)
         for(int i=0; i<succ.size();++i){
             temp_local_d = succ[i]->localD - succ[i]->c;
@@ -1,4 +1,5 @@
 #include "dagSched/Taskset.h"
+#include <oneapi/tbb/parallel_for.h>
 
 namespace dagSched{
 
@@ -11,6 +12,20 @@ void Taskset::print() const{
     std::cout<<"Max density: "<<maxDelta<<std::endl<<std::endl;
 }
 
+void Taskset::transitiveReduction(const bool parallel){
+    // tasks do not share vertices, so they can be reduced independently
+    auto reduce = [this](const size_t i){
+        tasks[i].transitiveReduction();
+        tasks[i].buildCSR();
+    };
+
+    if(parallel)
+        tbb::parallel_for(size_t(0), tasks.size(), reduce);
+    else
+        for(size_t i=0; i<tasks.size(); ++i)
+            reduce(i);
+}
+
 void Taskset::computeUtilization(){
     U = 0;
     for(const auto& task: tasks){
@@ -35,21 +50,18 @@ void Taskset::readTasksetFromYaml(const std::string& params_path){
     YAML::Node config   = YAML::LoadFile(params_path);
     YAML::Node tasks_node = config["tasks"];
 
+    const size_t first = tasks.size();
     for(size_t i=0; i<tasks_node.size(); i++){
         DAGTask t;
         t.readTaskFromYamlNode(tasks_node, i);
-
-        t.transitiveReduction();
-
-        t.computeWorstCaseWorkload();
-        t.computeVolume();
-        t.computeLength();
-        t.computeUtilization();
-        t.computeDensity();
-
         tasks.push_back(t);
     }
 
+    transitiveReduction();
+
+    for(size_t i=first; i<tasks.size(); i++)
+        tasks[i].computeMetrics();
+
     computeUtilization();
     computeHyperPeriod();
     computeMaxDensity();
@@ -58,37 +70,35 @@ void Taskset::readTasksetFromYaml(const std::string& params_path){
 void Taskset::readTasksetFromDOT(const std::string& dot_file_path){
     std::ifstream dot_paths(dot_file_path);
     std::string line;
+    const size_t first = tasks.size();
     while (std::getline(dot_paths, line)){
         DAGTask t;
         t.readTaskFromDOT(line);
-        t.transitiveReduction();
-
-        t.computeWorstCaseWorkload();
-        t.computeVolume();
-        t.computeLength();
-        t.computeUtilization();
-        t.computeDensity();
-
         tasks.push_back(t);
     }
 
     dot_paths.close();
 
+    transitiveReduction();
+
+    for(size_t i=first; i<tasks.size(); i++)
+        tasks[i].computeMetrics();
+
     computeUtilization();
     computeHyperPeriod();
     computeMaxDensity();
 }
 
-float Taskset::UUniFast_Upart(float& sum_U, const int i, const int n_tasks, const DAGTask& t ){
+float Taskset::UUniFast_Upart(float& sum_U, const int i, const int n_tasks, const DAGTask& t, RandomStream& rng){
     float next_sum_U=0, U_part = 0;
     double r;
     if(i < n_tasks-1){
-        r = ((double) rand() / (RAND_MAX));
+        r = rng.uniform();
         next_sum_U = sum_U * std::pow(r, 1./(n_tasks-i-1));
         U_part = sum_U - next_sum_U;
 
         while(t.getLength() > std::ceil(t.getWCW() / U_part)){
-            r = ((double) rand() / (RAND_MAX));
+            r = rng.uniform();
             next_sum_U = sum_U * std::pow(r, 1./(n_tasks-i-1));
             U_part = sum_U - next_sum_U;
         }
@@ -100,7 +110,8 @@ float Taskset::UUniFast_Upart(float& sum_U, const int i, const int n_tasks, cons
     return U_part;
 }
 
-void Taskset::generate_taskset_Melani(int n_tasks, const float U_tot, const int n_proc, GeneratorParams& gp){
+// all the random draws come from rng, so the same stream always gives the same taskset
+void Taskset::generate_taskset_Melani(int n_tasks, const float U_tot, const int n_proc, const GeneratorParams& gp, RandomStream& rng){
 
     float U_part = 0;
     float sum_U = U_tot;
@@ -108,80 +119,75 @@ void Taskset::generate_taskset_Melani(int n_tasks, const float U_tot, const int
 
     for(int i=0; i<n_tasks; ++i){
         DAGTask t;
-        t.expandTaskSeriesParallel(nullptr, nullptr,gp.recDepth,0,false,gp);
-        t.assignWCET(gp.Cmin, gp.Cmax);
+        t.expandTaskSeriesParallel(nullptr, nullptr,gp.recDepth,0,false,gp,rng);
+        t.assignWCET(gp.Cmin, gp.Cmax, rng);
         if( !(  gp.aType == AlgorithmType_t::FTP 
                 && gp.DAGType ==DAGType_t::DAG ) || gp.sType == SchedulingType_t::PARTITIONED )
-            t.makeItDag(gp.addProb);
+            t.makeItDag(gp.addProb, rng);
 
         t.transitiveReduction();
+        t.buildCSR();
 
         t.computeWorstCaseWorkload();
         t.computeVolume();
         t.computeLength();
 
         //random assignment of core in partitioned case
-        auto V = t.getVertices();
-        for(int j=0; j<V.size(); ++j)
-            V[j]->core = rand() % n_proc;
+        const int n_vertices = t.getVertices().size();
+        for(int j=0; j<n_vertices; ++j)
+            t.setSubTaskCore(j, rng.intRandMaxMin(0, n_proc));
 
         if(gp.DAGType == DAGType_t::TDAG){
             //random assignment of core types to subnodes
-            for(int j=0; j<V.size(); ++j)
-                V[j]->gamma = rand() % gp.typedProc.size();
+            for(int j=0; j<n_vertices; ++j)
+                t.setSubTaskType(j, rng.intRandMaxMin(0, gp.typedProc.size()));
         }
 
         if(gp.gType == GenerationType_t::VARYING_N){
 
-            U_part = UUniFast_Upart(sum_U, i, n_tasks, t) ;
+            U_part = UUniFast_Upart(sum_U, i, n_tasks, t, rng);
             // std::cout<<"U_part "<<U_part<<std::endl;
             t.assignSchedParametersUUniFast(U_part);
             if(gp.dtype == DeadlinesType_t::IMPLICIT)
                 t.setDeadline(t.getPeriod());
-            t.computeDensity();
-            t.computeUtilization();
-            U += t.getWCW() / t.getPeriod();
+            U += t.getUtilization();
         }
         else{
             if(n_tasks == 1){
                 float t_to_assign = std::floor(t.getWCW() / U_tot);
-                float d_to_assign = floatRandMaxMin(std::min(t.getLength(), t_to_assign), t_to_assign);
+                float d_to_assign = rng.floatRandMaxMin(std::min((float) t.getLength(), t_to_assign), t_to_assign);
                 t.assignFixedSchedParameters(t_to_assign, d_to_assign);
                 if(gp.dtype == DeadlinesType_t::IMPLICIT)
                     t.setDeadline(t.getPeriod());
 
-                t.computeDensity();
-                t.computeUtilization();
-                U += t.getWCW() / t.getPeriod();
+                U += t.getUtilization();
             }
             else{
 
-                t.assignSchedParameters(gp.beta);
+                t.assignSchedParameters(gp.beta, rng);
                 if(gp.dtype == DeadlinesType_t::IMPLICIT)
                     t.setDeadline(t.getPeriod());
 
-                t.computeDensity();
-                t.computeUtilization();
-                U += t.getWCW() / t.getPeriod();
+                U += t.getUtilization();
 
                 if( U > U_tot || i == n_tasks - 1){
-                    float U_prev = U - t.getWCW() / t.getPeriod();
+                    float U_prev = U - t.getUtilization();
                     float U_target = U_tot - U_prev;
                     float t_to_assign = std::floor(t.getWCW() / U_target);
-                    float d_to_assign = floatRandMaxMin(std::min(t.getLength(), t_to_assign), t_to_assign);;
+                    float d_to_assign = rng.floatRandMaxMin(std::min((float) t.getLength(), t_to_assign), t_to_assign);;
                     if(gp.dtype == DeadlinesType_t::IMPLICIT)
                         d_to_assign = t_to_assign;
                     t.assignFixedSchedParameters(t_to_assign, d_to_assign);
-                    t.computeDensity();
-                    t.computeUtilization();
-                    U = U_prev + t.getWCW() / t.getPeriod();
+                    U = U_prev + t.getUtilization();
                     n_tasks = i;
+                    t.computeMetrics();
                     tasks.push_back(t);
                     break;
                 }
             }
         }
 
+        t.computeMetrics();
         tasks.push_back(t);
     }
 
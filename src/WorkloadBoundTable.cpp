@@ -0,0 +1,31 @@
+#include "dagSched/WorkloadBoundTable.h"
+
+namespace dagSched{
+
+WorkloadBoundTable::WorkloadBoundTable(const Taskset& taskset){
+    const int n = taskset.tasks.size();
+    wcw.resize(n);
+    T.resize(n);
+    R.resize(n);
+    bound.resize(n);
+
+    for(int x=0; x<n; ++x){
+        wcw[x] = taskset.tasks[x].getWorstCaseWorkload();
+        T[x] = taskset.tasks[x].getPeriod();
+        R[x] = taskset.tasks[x].R;
+    }
+}
+
+const float* WorkloadBoundTable::bounds(const int n, const float t, const int m){
+    const float* w = wcw.data();
+    const float* p = T.data();
+    const float* r = R.data();
+    float* b = bound.data();
+
+    for(int x=0; x<n; ++x)
+        b[x] = workloadBound(w[x], p[x], r[x], t, m);
+
+    return b;
+}
+
+}
@@ -0,0 +1,34 @@
+#include "dagSched/WorkloadDistribution.h"
+
+#include <algorithm>
+
+namespace dagSched{
+
+WorkloadDistribution::WorkloadDistribution(const std::vector<std::pair<float, float>>& WD, const bool fromEnd): WD(WD){
+    const int n = WD.size();
+    breaks.resize(n + 1);
+    cumul.resize(n + 1);
+    heights.resize(n);
+
+    breaks[0] = 0;
+    cumul[0] = 0;
+    for(int k=0; k<n; ++k){
+        const std::pair<float, float>& wd = fromEnd ? WD[n - 1 - k] : WD[k];
+        heights[k] = wd.second;
+        breaks[k + 1] = breaks[k] + wd.first;
+        cumul[k + 1] = cumul[k] + wd.second * wd.first;
+    }
+}
+
+float WorkloadDistribution::workload(const float x) const{
+    if(x <= 0)
+        return 0;
+
+    // 最后一个不大于x的断点: 之前的区间完全计入, 所在区间部分计入
+    const int k = std::upper_bound(breaks.begin(), breaks.end(), x) - breaks.begin() - 1;
+    if(k >= heights.size())
+        return cumul[k];
+    return cumul[k] + heights[k] * (x - breaks[k]);
+}
+
+}
@@ -10,8 +10,8 @@ bool GP_FP_EDF_Baruah2012_C(const DAGTask& task, const int m){
     if(!(task.getDeadline() <= task.getPeriod()))
         FatalError("This test requires a constrained deadline task");
 
-    if( (m-1) * task.getLength() / task.getDeadline() + 
-        2 * task.getVolume() / task.getPeriod() <= m    )
+    if( (m-1) * (float) task.getLength() / task.getDeadline() + 
+        2 * (float) task.getVolume() / task.getPeriod() <= m    )
         return true;
     return false;
 
@@ -1,4 +1,5 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
 
 // Improved Multiprocessor Global Schedulability Analysis of Sporadic DAG Task Systems (ECRTS 2014)
 
@@ -8,13 +9,12 @@ float work(const DAGTask& t, const float interval, const float sigma){
     DAGTask t1 = t;
     t1.cloneVertices(t.getVertices());
 
-    for(auto& v:t1.getVertices())
-        v->c /= sigma;
+    const auto& V = t1.getVertices();
+    for(int i=0; i<V.size(); ++i)
+        t1.setSubTaskWCET(i, toTime(V[i]->c / sigma));
 
-    t1.computeVolume();
-    t1.computeAccWorkload();
-    t1.computeLength();
-    t1.computeLocalOffsets();
+    // volume and offsets of the scaled copy are computed on demand
+    const std::vector<Time_t>& localO = t1.getLocalOffsets();
 
     float n_full = 0, n_part = 0, work_part = 0;
 
@@ -34,7 +34,7 @@ float work(const DAGTask& t, const float interval, const float sigma){
         curr_r -= t.getDeadline();
 
         for(auto v1: t1.getVertices()){
-            vert_r = curr_r + v1->localO;
+            vert_r = curr_r + localO[v1->id];
 
             if(vert_r  >= 0)
                 work_part += v1->c;
@@ -59,15 +59,17 @@ float work(const Taskset& taskset, const float interval, const float sigma ){
 std::vector<float> getTestingSet(const Taskset& taskset, const float sigma, const float bound ){
     std::set<float> interval_set;
 
-    for(const auto&task: taskset.tasks){
+    for(int x=0; x<taskset.tasks.size(); ++x){
+        const DAGTask& task = taskset.tasks[x];
         
         std::vector<float> lambda_set;
         std::vector<float> t_lambda_up;
         std::vector<float> t_lambda_down;
         std::vector<std::pair<float, int>> l_table;
+        const std::vector<Time_t>& localO = task.getLocalOffsets();
         for(const auto&v: task.getVertices()){
-            t_lambda_up.push_back(v->localO);
-            t_lambda_down.push_back(v->localO + v->c);
+            t_lambda_up.push_back(localO[v->id]);
+            t_lambda_down.push_back(localO[v->id] + v->c);
         }
 
         std::sort(t_lambda_up.begin(), t_lambda_up.end());
@@ -169,11 +171,9 @@ bool GP_FP_EDF_Baruah2014_C(Taskset taskset, const int m){
 
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
-    for(auto& task:taskset.tasks){
-        if(!(task.getDeadline() <= task.getPeriod()))
+    for(int x=0; x<taskset.tasks.size(); ++x){
+        if(!(taskset.tasks[x].getDeadline() <= taskset.tasks[x].getPeriod()))
             FatalError("This test requires constrained deadline tasks");
-
-        task.computeLocalOffsets();
     }
 
     bool sched = true;
@@ -192,6 +192,8 @@ bool GP_FP_EDF_Baruah2014_C(Taskset taskset, const int m){
         tot_vol += t.getVolume();
 
     while(true){
+        if(budgetExhausted())
+            return false;
         if (sigma_tmp > ( m - U - eps ) / ( m - 1 ))
             return false;
             
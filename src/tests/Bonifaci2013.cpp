@@ -9,9 +9,9 @@ bool GP_FP_EDF_Bonifaci2013_A(const Taskset& taskset, const int m){
     float constr_contrib = 0, unconstr_contrib = 0;
     for(const auto& task:taskset.tasks){
         if(task.getPeriod() <= task.getDeadline())
-            unconstr_contrib +=  task.getVolume() /  task.getPeriod();
+            unconstr_contrib +=  (float) task.getVolume() /  task.getPeriod();
         else
-            constr_contrib +=  task.getVolume() /  task.getDeadline();
+            constr_contrib +=  (float) task.getVolume() /  task.getDeadline();
 
         if(task.getLength() > task.getDeadline() / 3. )
             return false;
@@ -27,7 +27,7 @@ bool GP_FP_DM_Bonifaci2013_A(const Taskset& taskset, const int m){
     float constr_contrib = 0, unconstr_contrib = 0;
     for(const auto& task:taskset.tasks){
         if(task.getPeriod() <= 2 * task.getDeadline())
-            unconstr_contrib +=  task.getVolume() /  task.getPeriod();
+            unconstr_contrib +=  (float) task.getVolume() /  task.getPeriod();
         else
             constr_contrib +=  task.getVolume() / (4. *  task.getDeadline());
 
@@ -50,9 +50,9 @@ bool GP_FP_DM_Bonifaci2013_C(const Taskset& taskset, const int m){
         }
 
         if(task.getPeriod() <= 2 * task.getDeadline())
-            unconstr_contrib +=  task.getVolume() /  task.getPeriod();
+            unconstr_contrib +=  (float) task.getVolume() /  task.getPeriod();
         else
-            constr_contrib +=  task.getVolume() /  task.getDeadline();
+            constr_contrib +=  (float) task.getVolume() /  task.getDeadline();
 
         if(task.getLength() > task.getDeadline() / 4. )
             return false;
@@ -1,38 +1,62 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/AnalysisScratch.h"
+#include "dagSched/CoreTable.h"
+
+#include <map>
+#include <tuple>
 
 namespace dagSched{
 
+// 一个片段(路径的一段)上computeWCRTssCasini的结果
+struct segmentResult{
+    std::vector<float> S;       // 片段的挂起时间
+    float Sub = 0;              // 其他处理器上子片段的响应时间之和
+    std::vector<float> R_ss;    // 每个本地顶点的响应时间
+    float R = 0;                // 片段的响应时间
+};
+
+// 一次迭代中的分析缓存
+// scratch中的响应时间只在迭代之间改变, 因此在一次迭代中阻塞和干扰只取决于(任务, 处理器, 区间),
+// 片段的结果只取决于片段本身和由RTs得到的挂起时间S、Sub。相同输入的计算直接重用之前的结果,
+// 分析结果与不使用缓存时完全相同。
+struct casiniCache{
+    std::map<std::vector<int>, std::vector<segmentResult>> segments;         // 当前任务的片段, 同一片段可能因RTs不同有多个结果
+    std::map<std::tuple<int,int,int,float>, std::vector<float>> blocking;   // (任务, 处理器, k, 区间) -> 多重集B
+    std::map<std::tuple<int,int,float>, float> interference;                // (任务, 处理器, 区间) -> 最大干扰
+};
+
 float computeSI(const std::vector<int>& path, const DAGTask& task){
     // lemma 8
     std::vector<int> self;
     std::vector<int> path_cores;
 
-    std::vector<SubTask*> V = task.getVertices();
+    const std::vector<SubTask*>& V = task.getVertices();
 
-    auto desc = task.getSubTaskDescendants(path.back());
-    auto ancst = task.getSubTaskAncestors(path[0]);
+    // 祖先和后代的判断用可达性矩阵, 每个顶点O(1)
+    const ReachabilityMatrix& reach = task.getReachability();
 
     int core_id = V[path[0]]->core;
 
     if(METHOD_VERBOSE){
         printVector<int>(path, "path computeSI");
         std::cout<<"Ancst:";
-        for(auto a:ancst)
+        for(auto a:task.getSubTaskAncestors(path[0]))
             std::cout<<a->id<<" ";
         std::cout<<std::endl;
 
         std::cout<<"Desc:";
-        for(auto d:desc)
+        for(auto d:task.getSubTaskDescendants(path.back()))
             std::cout<<d->id<<" ";
         std::cout<<std::endl;
     }
 
     for(int i=0; i<V.size(); ++i){
         
-        if( std::find(path.begin(), path.end(), V[i]->id) == path.end() && //does not belong to the path
-            V[i]->core == core_id && // if it's on the same core as start and end
-            std::find(ancst.begin(), ancst.end(), V[i]) == ancst.end() && // is not an ancestor of the start
-            std::find(desc.begin(), desc.end(), V[i]) == desc.end() )// is not a descendant of the end
+        if( V[i]->core == core_id && // if it's on the same core as start and end
+            std::find(path.begin(), path.end(), V[i]->id) == path.end() && //does not belong to the path
+            !reach.reaches(i, path[0]) && // is not an ancestor of the start
+            !reach.reaches(path.back(), i) )// is not a descendant of the end
             self.push_back(V[i]->id);
     }
 
@@ -45,19 +69,22 @@ float computeSI(const std::vector<int>& path, const DAGTask& task){
     return SI;
 }
 
-std::vector<float> computeMultisetB(const int k, const float interval, const Taskset& taskset, const int task_idx, int core_id ){
+std::vector<float> computeMultisetB(const int k, const float interval, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, int core_id ){
     float eta;
     std::vector<float> multiset_C;
     for(int y=task_idx+1; y<taskset.tasks.size(); ++y){
-        std::vector<SubTask*> V = taskset.tasks[y].getVertices();
-        for(int j=0;j<V.size(); ++j)
-            if(V[j]->core == core_id)
-                eta = 1 + std::floor( ( interval + V[j]->r - V[j]->c) / taskset.tasks[y].getPeriod() );
-
-        for(int j=0;j<V.size(); ++j)
-            if(V[j]->core == core_id)
-                for(int e=0 ; e < eta ; ++e)
-                    multiset_C.push_back(V[j]->c);
+        const std::vector<SubTask*>& V = taskset.tasks[y].getVertices();
+        const int* begin = table.verticesBegin(y, core_id);
+        const int* end = table.verticesEnd(y, core_id);
+        // eta of the last node of the core
+        if(begin != end){
+            const int j = *(end - 1);
+            eta = 1 + std::floor( ( interval + scratch[y].r[j] - V[j]->c) / taskset.tasks[y].getPeriod() );
+        }
+
+        for(const int* j = begin; j != end; ++j)
+            for(int e=0 ; e < eta ; ++e)
+                multiset_C.push_back(V[*j]->c);
     }
 
 
@@ -70,24 +97,21 @@ std::vector<float> computeMultisetB(const int k, const float interval, const Tas
     return multiset_B;
 }
 
-float computeMaximumInterference(const float interval, const Taskset& taskset, const int task_idx, const int core_id){
+float computeMaximumInterference(const float interval, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, const int core_id){
 
     float first_term = 0, second_term = 0, R_bar;  
     for(int y=0; y<task_idx; ++y){
-        std::vector<SubTask*> V = taskset.tasks[y].getVertices();
-
-        R_bar = 0;
-        for(int j=0; j<V.size(); ++j){
-            if(V[j]->core == core_id){
-                first_term += V[j]->c * ( 1 + std::floor( (interval + V[j]->r - V[j]->c) / taskset.tasks[y].getPeriod() ));
+        const std::vector<SubTask*>& V = taskset.tasks[y].getVertices();
 
-                if(V[j]->r > R_bar)
-                    R_bar = V[j]->r;
+        for(const int* it = table.verticesBegin(y, core_id); it != table.verticesEnd(y, core_id); ++it){
+            const int j = *it;
+            first_term += V[j]->c * ( 1 + std::floor( (interval + scratch[y].r[j] - V[j]->c) / taskset.tasks[y].getPeriod() ));
 
-                if(METHOD_VERBOSE) std::cout<<"maxinterf --> y: "<<y<<", "<<j<<" "<<V[j]->r<<" "<<R_bar<<std::endl;
-            }
+            if(METHOD_VERBOSE) std::cout<<"maxinterf --> y: "<<y<<", "<<j<<" "<<scratch[y].r[j]<<std::endl;
         }
-        second_term += (1 + std::floor( (interval + R_bar - taskset.tasks[y].getpVolume()[core_id] ) / taskset.tasks[y].getPeriod())) * taskset.tasks[y].getpVolume()[core_id];
+        R_bar = table.maxResponse(y, core_id);
+        const Time_t p_vol = table.volume(y, core_id);
+        second_term += (1 + std::floor( (interval + R_bar - p_vol ) / taskset.tasks[y].getPeriod())) * p_vol;
     }
 
     if(METHOD_VERBOSE) std::cout<<"interval:"<<interval<<std::endl;
@@ -97,7 +121,23 @@ float computeMaximumInterference(const float interval, const Taskset& taskset, c
     return std::min(first_term, second_term);
 }
 
-float Theorem1Casini2018(const SSTask& tau_ss,  const Taskset& taskset, const int task_idx, const float SI){
+const std::vector<float>& cachedMultisetB(const int k, const float interval, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, int core_id, casiniCache& cache){
+    const auto key = std::make_tuple(task_idx, core_id, k, interval);
+    auto it = cache.blocking.find(key);
+    if(it == cache.blocking.end())
+        it = cache.blocking.emplace(key, computeMultisetB(k, interval, taskset, scratch, table, task_idx, core_id)).first;
+    return it->second;
+}
+
+float cachedMaximumInterference(const float interval, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, const int core_id, casiniCache& cache){
+    const auto key = std::make_tuple(task_idx, core_id, interval);
+    auto it = cache.interference.find(key);
+    if(it == cache.interference.end())
+        it = cache.interference.emplace(key, computeMaximumInterference(interval, taskset, scratch, table, task_idx, core_id)).first;
+    return it->second;
+}
+
+float Theorem1Casini2018(const SSTask& tau_ss,  const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, const float SI, casiniCache& cache){
 
     float base = 0;
 
@@ -121,7 +161,7 @@ float Theorem1Casini2018(const SSTask& tau_ss,  const Taskset& taskset, const in
         R_prime_old = R_prime;
 
         //computing blocking from lp
-        multiset_B = computeMultisetB(tau_ss.C.size(), R_prime_old,  taskset, task_idx, tau_ss.coreId);
+        multiset_B = cachedMultisetB(tau_ss.C.size(), R_prime_old,  taskset, scratch, table, task_idx, tau_ss.coreId, cache);
         if(METHOD_VERBOSE) printVector<float>(multiset_B, "multiset_B");
         b = 0;
         for(const auto B:multiset_B)
@@ -130,7 +170,7 @@ float Theorem1Casini2018(const SSTask& tau_ss,  const Taskset& taskset, const in
         if(METHOD_VERBOSE) std::cout<<"b: "<<b<<std::endl;
 
         //computing interference from hp
-        I = computeMaximumInterference(R_prime_old, taskset, task_idx, tau_ss.coreId);
+        I = cachedMaximumInterference(R_prime_old, taskset, scratch, table, task_idx, tau_ss.coreId, cache);
 
         if(METHOD_VERBOSE) std::cout<<"I: "<<I<<std::endl;
 
@@ -145,7 +185,7 @@ float Theorem1Casini2018(const SSTask& tau_ss,  const Taskset& taskset, const in
 
 }
 
-float Theorem2Casini2018(const int k, const SSTask& tau_ss, const std::vector<float>& R_ss, const Taskset& taskset, const int task_idx, const float SI){
+float Theorem2Casini2018(const int k, const SSTask& tau_ss, const std::vector<float>& R_ss, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, const float SI, casiniCache& cache){
     float R = 0;
 
     for(int i=0; i<= k; ++i)
@@ -157,7 +197,7 @@ float Theorem2Casini2018(const int k, const SSTask& tau_ss, const std::vector<fl
     R += std::min(S_part, tau_ss.Sub);
 
     float r_k = (k == 0)? 0 : R_ss[k-1] + tau_ss.S[k-1];
-    std::vector<float> multiset_B = computeMultisetB(k+1, r_k, taskset, task_idx, tau_ss.coreId);
+    const std::vector<float>& multiset_B = cachedMultisetB(k+1, r_k, taskset, scratch, table, task_idx, tau_ss.coreId, cache);
 
     float bI = 0;
     float delta = 0;
@@ -171,7 +211,7 @@ float Theorem2Casini2018(const int k, const SSTask& tau_ss, const std::vector<fl
         //equation 6
         // while(new_delta != delta){
             delta = new_delta;
-            new_delta = B + computeMaximumInterference(delta, taskset, task_idx, tau_ss.coreId) + SI;
+            new_delta = B + cachedMaximumInterference(delta, taskset, scratch, table, task_idx, tau_ss.coreId, cache) + SI;
         // }
 
         bI += new_delta;
@@ -184,19 +224,30 @@ float Theorem2Casini2018(const int k, const SSTask& tau_ss, const std::vector<fl
 }
 
 
-float computeWCRTssCasini(const SSTask& tau_ss, const std::vector<int>& path_ss, const Taskset& taskset, const int task_idx, std::vector<std::vector<float>>& RTs){
+float computeWCRTssCasini(const SSTask& tau_ss, const std::vector<int>& path_ss, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, std::vector<std::vector<float>>& RTs, casiniCache& cache){
+
+    std::vector<segmentResult>& cached = cache.segments[path_ss];
+    for(const auto& c: cached){
+        if(c.Sub == tau_ss.Sub && c.S == tau_ss.S){
+            // 重放对本地顶点响应时间的更新
+            for(int j = 0; j< tau_ss.C.size(); ++j)
+                if(c.R_ss[j] < RTs[tau_ss.CvID[j]][tau_ss.CvID[j]])
+                    RTs[tau_ss.CvID[j]][tau_ss.CvID[j]] = c.R_ss[j];
+            return c.R;
+        }
+    }
 
     float SI = computeSI(path_ss, taskset.tasks[task_idx]);
 
     if(METHOD_VERBOSE) std::cout<<"SI:"<<SI<<std::endl;
     std::vector<float> R_ss(tau_ss.C.size(), 0);
     
-    float R1 = Theorem1Casini2018(tau_ss, taskset, task_idx, SI);
+    float R1 = Theorem1Casini2018(tau_ss, taskset, scratch, table, task_idx, SI, cache);
     if(METHOD_VERBOSE) std::cout<<"R1: "<<R1<<std::endl;
     float R2, R1_j;
     float final_R = 0;
     for(int j = 0; j< tau_ss.C.size(); ++j){
-        R2 = Theorem2Casini2018(j, tau_ss, R_ss, taskset, task_idx, SI);
+        R2 = Theorem2Casini2018(j, tau_ss, R_ss, taskset, scratch, table, task_idx, SI, cache);
 
         R1_j = R1;
         for(int k=j+1; k<tau_ss.C.size(); ++k)
@@ -216,23 +267,30 @@ float computeWCRTssCasini(const SSTask& tau_ss, const std::vector<int>& path_ss,
 
     if(METHOD_VERBOSE) std::cout<<"final R: "<<final_R<<std::endl;
 
+    segmentResult res;
+    res.S = tau_ss.S;
+    res.Sub = tau_ss.Sub;
+    res.R_ss = R_ss;
+    res.R = final_R;
+    cached.push_back(std::move(res));
+
     return final_R;
 }
 
 
-float pathAnalysisImproved(const std::vector<int>& path_ss, const Taskset& taskset, const int task_idx, std::vector<std::vector<float>>& RTs, const bool is_root ){
+float pathAnalysisImproved(const std::vector<int>& path_ss, const Taskset& taskset, const AnalysisScratch& scratch, const CoreTable& table, const int task_idx, std::vector<std::vector<float>>& RTs, casiniCache& cache, const bool is_root ){
     //algorithm 5
     if(METHOD_VERBOSE) std::cout<<"starting path analysis improved"<<std::endl;
     if(METHOD_VERBOSE) printVector<int>(path_ss, "path ss");
 
-    std::vector<SubTask*> V = taskset.tasks[task_idx].getVertices();
+    const std::vector<SubTask*>& V = taskset.tasks[task_idx].getVertices();
     SubTask* first = V[path_ss[0]];
     SubTask* last = V[path_ss.back()];
     int core_ss = first->core;
 
     if(path_ss.size() == 1){
         SSTask task_ss = deriveSSTask(V, path_ss, first->core, RTs);
-        float R_task_ss = computeWCRTssCasini(task_ss, path_ss, taskset, task_idx, RTs);
+        float R_task_ss = computeWCRTssCasini(task_ss, path_ss, taskset, scratch, table, task_idx, RTs, cache);
         RTs[first->id][last->id] = R_task_ss;
         if(METHOD_VERBOSE) std::cout<<"RT "<<first->id<<", "<<last->id<<": "<<R_task_ss<<std::endl;
     }
@@ -240,9 +298,9 @@ float pathAnalysisImproved(const std::vector<int>& path_ss, const Taskset& tasks
         if(first->core == last->core){
             std::vector<int> path_sub (path_ss.begin()+1, path_ss.end()-1);
             if(path_sub.size() > 0)
-                pathAnalysisImproved(path_sub, taskset, task_idx, RTs, false);
+                pathAnalysisImproved(path_sub, taskset, scratch, table, task_idx, RTs, cache, false);
             SSTask task_ss = deriveSSTask(V, path_ss, first->core, RTs);
-            float R_task_ss = computeWCRTssCasini(task_ss, path_ss, taskset, task_idx, RTs);
+            float R_task_ss = computeWCRTssCasini(task_ss, path_ss, taskset, scratch, table, task_idx, RTs, cache);
             RTs[first->id][last->id] = R_task_ss - task_ss.Sub;
             if(METHOD_VERBOSE) std::cout<<"RT "<<first->id<<", "<<last->id<<": "<<RTs[first->id][last->id]<<std::endl;
         }
@@ -254,9 +312,9 @@ float pathAnalysisImproved(const std::vector<int>& path_ss, const Taskset& tasks
                     break;
             }
             std::vector<int> path_sub (path_ss.begin()+i, path_ss.end());
-            pathAnalysisImproved(path_sub, taskset, task_idx, RTs, false);
+            pathAnalysisImproved(path_sub, taskset, scratch, table, task_idx, RTs, cache, false);
             std::vector<int> path_sub_2 (path_ss.begin(), path_ss.end()-1);
-            pathAnalysisImproved(path_sub_2, taskset, task_idx, RTs, false);
+            pathAnalysisImproved(path_sub_2, taskset, scratch, table, task_idx, RTs, cache, false);
         }
     }
 
@@ -301,10 +359,14 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
     //algorithm 3
 
-    std::vector<std::vector<float>> R_star(taskset.tasks.size());
+    // per-node response times live in the scratch buffer, the task graphs are not modified
+    AnalysisScratch scratch(taskset);
+    // per-core volumes and node lists, the max node response time per core follows the scratch
+    CoreTable table(taskset);
+
+    std::vector<std::vector<Time_t>> R_star(taskset.tasks.size());
     for(int x=0; x<taskset.tasks.size(); ++x){    
         taskset.tasks[x].R = 0;
-        taskset.tasks[x].computepVolume();
         
         std::vector<SubTask*> V = taskset.tasks[x].getVertices();
         R_star[x].resize(V.size());
@@ -316,7 +378,7 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
                 if(desc[j]->core == V[i]->core)
                     sum_desc_same_core += desc[j]->c;
             }
-            V[i]->r = taskset.tasks[x].getDeadline() - sum_desc_same_core;
+            scratch[x].r[i] = taskset.tasks[x].getDeadline() - sum_desc_same_core;
         }
     }
         
@@ -325,6 +387,10 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
 
     int it=0;
     while(at_least_one_update){
+        if(budgetExhausted())
+            return false;
+
+        table.updateMaxResponse(scratch);
 
         for(int x=0; x<taskset.tasks.size(); ++x)
             taskset.tasks[x].R = 0;
@@ -337,12 +403,21 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
             for(int i=0; i<R_star[x].size(); ++i)
                 R_star[x][i] = 0;
 
+        // the scratch response times change only between iterations, so what is computed in
+        // this iteration is shared by all the paths; segments are per task
+        casiniCache cache;
         for(int x=0; x<taskset.tasks.size(); ++x){    
-            std::vector<std::vector<int>> all_paths = taskset.tasks[x].computeAllPaths();
             std::vector<SubTask*> V = taskset.tasks[x].getVertices();
             std::vector<std::vector<float>> RTs (V.size(), std::vector<float>(V.size(), 0));
-            for(const auto& p:all_paths){
-                float RT = pathAnalysisImproved(p,taskset, x, RTs, true);
+            cache.segments.clear();
+
+            // paths are streamed one at a time, they are never all stored
+            PathEnumerator paths(taskset.tasks[x].getCSR());
+            while(paths.next()){
+                if(budgetExhausted())
+                    return false;
+                const std::vector<int>& p = paths.path();
+                Time_t RT = toTime(pathAnalysisImproved(p, taskset, scratch, table, x, RTs, cache, true));
                 taskset.tasks[x].R = std::max(taskset.tasks[x].R, RT);
                 
                 if(METHOD_VERBOSE) std::cout<<"taskset.tasks["<<x<<"].R "<<taskset.tasks[x].R<<std::endl;
@@ -350,7 +425,7 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
                 for(const auto& v:p){
                     if(METHOD_VERBOSE) std::cout<<"RT vv: "<<RTs[v][v]<<std::endl;
 
-                    R_star[x][v] = std::max(R_star[x][v], RTs[v][v]);
+                    R_star[x][v] = std::max(R_star[x][v], toTime(RTs[v][v]));
                 }
             }
         }
@@ -364,14 +439,14 @@ bool P_LP_FTP_Casini2018_C(Taskset taskset, const int m){
             return true;
 
         for(int x=0; x<R_star.size(); ++x){
-            std::vector<SubTask*> V = taskset.tasks[x].getVertices();
+            std::vector<Time_t>& r = scratch[x].r;
             for(int i=0; i<R_star[x].size(); ++i){
-                if(R_star[x][i] < V[i]->r && R_star[x][i] !=0){
-                    if(METHOD_VERBOSE) std::cout<<"\t\tR*: "<< R_star[x][i]<<" R_: "<< V[i]->r<<std::endl;
+                if(R_star[x][i] < r[i] && R_star[x][i] !=0){
+                    if(METHOD_VERBOSE) std::cout<<"\t\tR*: "<< R_star[x][i]<<" R_: "<< r[i]<<std::endl;
                     at_least_one_update = true;
                     }
                 if(R_star[x][i] > 0)
-                    V[i]->r = std::min(R_star[x][i], V[i]->r);
+                    r[i] = std::min(R_star[x][i], r[i]);
             }
         }
     }
@@ -396,7 +471,7 @@ bool P_LP_FTP_Casini2018_C_withAssignment(Taskset taskset, const int m, const Pa
 
         std::vector<SubTask*> V = taskset.tasks[x].getVertices();
         for(int i=0; i<V.size(); ++i){
-            SubTask * v = new SubTask;
+            SubTask * v = taskset_prime.tasks[x].createSubTask();
             v->c = V[i]->c;
             v->id = V[i]->id;
             V_prime.push_back(v);
@@ -415,7 +490,7 @@ bool P_LP_FTP_Casini2018_C_withAssignment(Taskset taskset, const int m, const Pa
             taskset_prime.tasks[x].computeUtilization();
 
 
-            std::vector<int> candidates_cores = getCandidatesProcInOrder(proc_util, V[i]->c / taskset.tasks[x].getPeriod(), c_order);
+            std::vector<int> candidates_cores = getCandidatesProcInOrder(proc_util, (float) V[i]->c / taskset.tasks[x].getPeriod(), c_order);
             if(candidates_cores.empty()){
                 for(int y=0; y<taskset_prime.tasks.size();++y)
                     taskset_prime.tasks[y].destroyVerices();
@@ -425,11 +500,12 @@ bool P_LP_FTP_Casini2018_C_withAssignment(Taskset taskset, const int m, const Pa
             bool found = false;
 
             for(int p=0; p<candidates_cores.size();++p){
-                V_prime[i]->core = candidates_cores[p];
+                taskset_prime.tasks[x].setSubTaskCore(i, candidates_cores[p]);
 
+                // the assignment is kept only in taskset_prime: the vertices of taskset
+                // are shared with the caller and must not be modified
                 if(P_LP_FTP_Casini2018_C(taskset_prime, m)){
-                    V[i]->core = candidates_cores[p];
-                    proc_util[p] += V[i]->c / taskset.tasks[x].getPeriod();
+                    proc_util[p] += (float) V[i]->c / taskset.tasks[x].getPeriod();
                     found = true;
                     break;
                 }
@@ -1,8 +1,10 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/CoreTable.h"
 
 namespace dagSched{
 
-std::vector<int> computeSelfOfPath(const std::vector<int>& path, std::vector<SubTask*> V){
+std::vector<int> computeSelfOfPath(const std::vector<int>& path, const std::vector<SubTask*>& V){
     //equation 4
     std::vector<int> self;
     std::vector<int> path_cores;
@@ -72,14 +74,14 @@ SSTask deriveSSTask(const std::vector<SubTask*>& V, const std::vector<int>& path
     return task_ss;
 }
 
-float computeWCRT(const float base, const std::vector<int>& self_ss, const std::vector<int>& hp_ss, const int core_id, const Taskset& taskset, const int task_idx){
+float computeWCRT(const float base, const std::vector<int>& self_ss, const std::vector<int>& hp_ss, const int core_id, const Taskset& taskset, const CoreTable& table, const int task_idx){
     float R_ss = 0;
     float new_R_ss = base;
     float self_int = 0;
     float high_int = 0;
     
     //equation 7
-    std::vector<SubTask*> V = taskset.tasks[task_idx].getVertices();
+    const std::vector<SubTask*>& V = taskset.tasks[task_idx].getVertices();
     // while(R_ss != new_R_ss){
         R_ss = new_R_ss;
         
@@ -90,7 +92,7 @@ float computeWCRT(const float base, const std::vector<int>& self_ss, const std::
         high_int = 0;
         
         for(const auto hp:hp_ss)
-            high_int+= std::ceil( R_ss / taskset.tasks[hp].getPeriod()) * taskset.tasks[hp].getpVolume()[core_id];
+            high_int+= std::ceil( R_ss / taskset.tasks[hp].getPeriod()) * table.volume(hp, core_id);
 
         if(METHOD_VERBOSE) std::cout<<"self_int: "<<self_int<<" high int: "<<high_int<<std::endl;
         new_R_ss = base + high_int + self_int;
@@ -99,7 +101,7 @@ float computeWCRT(const float base, const std::vector<int>& self_ss, const std::
     return new_R_ss;
 }
 
-float computeWCRTss(const SSTask& tau_ss, const std::vector<int>& self_ss, const std::vector<int>& hp_ss, const int core_id, const Taskset& taskset, const int task_idx, const bool joint){
+float computeWCRTss(const SSTask& tau_ss, const std::vector<int>& self_ss, const std::vector<int>& hp_ss, const int core_id, const Taskset& taskset, const CoreTable& table, const int task_idx, const bool joint){
 
     float WCRT_ss = 0;
     if (joint){
@@ -108,25 +110,25 @@ float computeWCRTss(const SSTask& tau_ss, const std::vector<int>& self_ss, const
         for(int i=0; i<tau_ss.C.size(); ++i)
             WCRT_ss +=  tau_ss.C[i];
 
-        WCRT_ss = computeWCRT(WCRT_ss, self_ss, hp_ss, core_id, taskset, task_idx);
+        WCRT_ss = computeWCRT(WCRT_ss, self_ss, hp_ss, core_id, taskset, table, task_idx);
     }
     else{ //split
         //equation 9 
         WCRT_ss += tau_ss.Sub;
         for(int i=0; i<tau_ss.C.size(); ++i)
-            WCRT_ss += computeWCRT(tau_ss.C[i], self_ss, hp_ss, core_id, taskset, task_idx);
+            WCRT_ss += computeWCRT(tau_ss.C[i], self_ss, hp_ss, core_id, taskset, table, task_idx);
 
     }
 
     return WCRT_ss;
 }
 
-void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self, const Taskset& taskset, const int task_idx, std::vector<std::vector<float>>& RTs, const bool joint, bool is_root ){
+void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self, const Taskset& taskset, const CoreTable& table, const int task_idx, std::vector<std::vector<float>>& RTs, const bool joint, bool is_root ){
     //algorithm 1
     if(METHOD_VERBOSE) std::cout<<"starting path analysis"<<std::endl;
     if(METHOD_VERBOSE) printVector<int>(path_ss, "path ss");
 
-    std::vector<SubTask*> V = taskset.tasks[task_idx].getVertices();
+    const std::vector<SubTask*>& V = taskset.tasks[task_idx].getVertices();
     SubTask* first = V[path_ss[0]];
     SubTask* last = V[path_ss.back()];
             
@@ -140,15 +142,10 @@ void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self,
             self_ss.push_back(self[i]);
     }
 
-    for(int i=0; i<task_idx; ++i){
-        std::vector<SubTask*> V_cur = taskset.tasks[i].getVertices();
-        for(int j=0; j<V_cur.size();++j){
-            if(V_cur[j]->core == first->core){
-                hp_ss.push_back(i);
-                break;
-            }
-        }
-    }
+    // higher priority tasks with at least a node on the same core
+    for(int i=0; i<task_idx; ++i)
+        if(table.hasVertices(i, first->core))
+            hp_ss.push_back(i);
 
     if(METHOD_VERBOSE) printVector<int>(hp_ss, "hp tasks");
     if(METHOD_VERBOSE) printVector<int>(self_ss, "self ss");
@@ -156,7 +153,7 @@ void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self,
 
 
     if(path_ss.size() == 1){
-        float new_R_path_ss =  computeWCRT(first->c, self_ss, hp_ss, first->core, taskset, task_idx);
+        float new_R_path_ss =  computeWCRT(first->c, self_ss, hp_ss, first->core, taskset, table, task_idx);
         RTs[first->id][last->id] = new_R_path_ss;
         if(METHOD_VERBOSE) std::cout<<"RT "<<first->id<<", "<<last->id<<": "<<new_R_path_ss<<std::endl;
     }
@@ -164,9 +161,9 @@ void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self,
         if(first->core == last->core){
             std::vector<int> path_sub (path_ss.begin()+1, path_ss.end()-1);
             if(path_sub.size() > 0)
-                pathAnalysis(path_sub, self, taskset, task_idx, RTs, joint, false);
+                pathAnalysis(path_sub, self, taskset, table, task_idx, RTs, joint, false);
             SSTask task_ss = deriveSSTask(V, path_ss, first->core, RTs);
-            float R_task_ss = computeWCRTss(task_ss, self_ss, hp_ss, first->core, taskset, task_idx, joint);
+            float R_task_ss = computeWCRTss(task_ss, self_ss, hp_ss, first->core, taskset, table, task_idx, joint);
             if(R_task_ss > RTs[first->id][last->id])
                 RTs[first->id][last->id] = R_task_ss;
             if(METHOD_VERBOSE) std::cout<<"RT "<<first->id<<", "<<last->id<<": "<<R_task_ss<<std::endl;
@@ -179,9 +176,9 @@ void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self,
                     break;
             }
             std::vector<int> path_sub (path_ss.begin()+i, path_ss.end());
-            pathAnalysis(path_sub, self, taskset, task_idx, RTs, joint, false);
+            pathAnalysis(path_sub, self, taskset, table, task_idx, RTs, joint, false);
             std::vector<int> path_sub_2 (path_ss.begin(), path_ss.end()-1);
-            pathAnalysis(path_sub_2, self, taskset, task_idx, RTs, joint, false);
+            pathAnalysis(path_sub_2, self, taskset, table, task_idx, RTs, joint, false);
         }
     }
 
@@ -214,17 +211,20 @@ void pathAnalysis(const std::vector<int>& path_ss, const std::vector<int>& self,
 
 }
 
-float computeWCRTDAG(const Taskset& taskset, const int task_idx, const bool joint){
+float computeWCRTDAG(const Taskset& taskset, const CoreTable& table, const int task_idx, const bool joint){
     //corollary 1
     
     std::vector<SubTask*> V = taskset.tasks[task_idx].getVertices();
     std::vector<std::vector<float>> RTs (V.size(), std::vector<float>(V.size(), 0));
 
-    //analyze each path
-    std::vector<std::vector<int>> all_paths= taskset.tasks[task_idx].computeAllPaths();
-    for(const auto& p:all_paths){
+    //analyze each path, paths are streamed one at a time
+    PathEnumerator paths(taskset.tasks[task_idx].getCSR());
+    while(paths.next()){
+        if(budgetExhausted())
+            break;
+        const std::vector<int>& p = paths.path();
         auto self =  computeSelfOfPath(p,V);
-        pathAnalysis(p, self, taskset, task_idx, RTs, joint, true);
+        pathAnalysis(p, self, taskset, table, task_idx, RTs, joint, true);
     }
 
     // compute max response time of paths
@@ -245,13 +245,13 @@ bool P_FP_FTP_Fonseca2016_C(Taskset taskset, const int m, const bool joint){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
     // std::vector<std::vector<float>> R(taskset.tasks.size());
 
-    std::map<int, float> pVol;
+    // per-core volumes and node lists of the sorted tasks
+    CoreTable table(taskset);
+
     for(int i=0; i<taskset.tasks.size(); ++i){
-        taskset.tasks[i].computepVolume();
-        pVol = taskset.tasks[i].getpVolume();
         taskset.tasks[i].R = 0;
 
-        for(const auto& p:pVol)
+        for(const auto& p:taskset.tasks[i].getpVolume())
             if(p.second > taskset.tasks[i].getDeadline())
                 return false;
     }
@@ -262,11 +262,11 @@ bool P_FP_FTP_Fonseca2016_C(Taskset taskset, const int m, const bool joint){
 
         for(int i=0; i<taskset.tasks.size(); ++i){
 
-            float R = std::max ( computeWCRTDAG(taskset, i, joint), taskset.tasks[i].R) ;
+            Time_t R = std::max ( toTime(computeWCRTDAG(taskset, table, i, joint)), taskset.tasks[i].R) ;
             if(R > taskset.tasks[i].getDeadline())
                 return false;
 
-            if(!areEqual<float>(R, taskset.tasks[i].R))
+            if(!areEqual<Time_t>(R, taskset.tasks[i].R))
                 at_least_one_update = true;
 
             if (R > taskset.tasks[i].R)
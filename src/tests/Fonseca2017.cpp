@@ -1,5 +1,7 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
 #include "dagSched/SP-Tree.h"
+#include "dagSched/WorkloadArtifacts.h"
 
 namespace dagSched{
 
@@ -8,7 +10,11 @@ namespace dagSched{
 std::vector<std::pair<float, float>> computeWorkloadDistributionCI(const DAGTask& task){
 
     std::vector<std::pair<float, float>> WD;
-    auto V = task.getVertices();
+    const auto& V = task.getVertices();
+
+    // offsets and finishing times are cached on the task, the task graph is not modified
+    const std::vector<Time_t>& localO = task.getLocalOffsets();
+    const std::vector<Time_t>& EFT = task.getEFTs();
 
     std::vector<float> F;
     std::set<float> F_set;
@@ -16,7 +22,7 @@ std::vector<std::pair<float, float>> computeWorkloadDistributionCI(const DAGTask
     F_set.insert(0);
 
     for(int i=0; i<V.size() ;++i)
-        F_set.insert(V[i]->EFT);
+        F_set.insert(EFT[i]);
     
     for(const auto& f:F_set)
         F.push_back(f);
@@ -31,7 +37,7 @@ std::vector<std::pair<float, float>> computeWorkloadDistributionCI(const DAGTask
         //height
         h = 0;
         for(int i=0; i<V.size() ;++i)
-            if (F[t-1] >= V[i]->localO && F[t-1] < V[i]->EFT)
+            if (F[t-1] >= localO[i] && F[t-1] < EFT[i])
                 h++;
 
         WD.push_back(std::make_pair(w,h));
@@ -41,23 +47,17 @@ std::vector<std::pair<float, float>> computeWorkloadDistributionCI(const DAGTask
     return WD;
 }
 
-float computeCarryInUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCI_y){
+float computeCarryInUpperBound(const DAGTask& task, const int interval, const WorkloadDistribution& WD_UCI_y){
 
     //equation 6 in the paper
+    //the i-th interval contributes the part of it that falls within interval - T + R from the end of WD_UCI
 
-    float CI = 0, CI_tmp = 0;
-
-    for(int i=0; i< WD_UCI_y.size();++i){
-        CI_tmp = interval - task.getPeriod() + task.R; 
-
-        for(int j=i+1; j< WD_UCI_y.size();++j)
-            CI_tmp -= WD_UCI_y[j].first;
-
-        CI += WD_UCI_y[i].second * std::max( float(0), std::min (WD_UCI_y[i].first, CI_tmp));
-    }
-
-    return CI;
+    float CI_tmp = interval - task.getPeriod() + task.R;
+    return WD_UCI_y.workload(CI_tmp);
+}
 
+float computeCarryInUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCI_y){
+    return computeCarryInUpperBound(task, interval, WorkloadDistribution(WD_UCI_y, true));
 }
 
 
@@ -65,24 +65,22 @@ float computeImprovedCarryInUpperBound(const DAGTask& task, const int interval,
     //theorem 2 in the paper
 
     float CI_up = computeCarryInUpperBound(task, interval, WD_UCI_y);
-    return std::min( CI_up, m * std::max( float(0) , interval - task.getPeriod() + task.R ));
+    return std::min( CI_up, m * std::max( float(0) , float(interval - task.getPeriod() + task.R) ));
 }
 
 
 
 
-void removeConflictingEdge(std::vector<SubTask*> & V, const int i, const int j, const std::vector<int> ordIDs){
+void removeConflictingEdge(DAGTask& t, std::vector<SubTask*> & V, const int i, const int j, const std::vector<int> ordIDs){
 
     // std::cout<<"removing:"<< V[j]->id <<" to "<< V[i]->id<<std::endl;
-    //removing conflicting edge
-    V[i]->pred.erase(std::remove(V[i]->pred.begin(), V[i]->pred.end(), V[j]), V[i]->pred.end());
-    V[j]->succ.erase(std::remove(V[j]->succ.begin(), V[j]->succ.end(), V[i]), V[j]->succ.end());
+    //removing conflicting edge (goes through the task so that its reachability cache is invalidated)
+    t.removeEdge(V[j], V[i]);
 
     // if V_j has no successor, link it to the end
     if(V[j]->succ.size() == 0 &&  j != ordIDs[ordIDs.size() - 1]){
         // std::cout<<"adding:"<< V[j]->id <<" to "<< V[ordIDs[ordIDs.size() - 1]]->id<<std::endl;
-        V[j]->succ.push_back(V[ordIDs[ordIDs.size() - 1]]);
-        V[ordIDs[ordIDs.size() - 1]]->pred.push_back(V[j]);
+        t.addEdge(V[j], V[ordIDs[ordIDs.size() - 1]]);
     }
 }
 
@@ -123,7 +121,7 @@ void convertDAGintoNFJDAG(DAGTask& t1, const int task_idx, bool save=false){
                             t1.isSuccessor(V[i], V[i]->pred[j]->succ[s], same_join);
                             if(!same_fork || !same_join){
                                 confl_edge = true;
-                                removeConflictingEdge(V, i, V[i]->pred[j]->id, ordIDs);
+                                removeConflictingEdge(t1, V, i, V[i]->pred[j]->id, ordIDs);
                             }
                         }
 
@@ -139,7 +137,7 @@ void convertDAGintoNFJDAG(DAGTask& t1, const int task_idx, bool save=false){
 
                             if(!same_fork || !same_join){
                                 confl_edge = true;
-                                removeConflictingEdge(V, i, V[i]->pred[j]->id, ordIDs);
+                                removeConflictingEdge(t1, V, i, V[i]->pred[j]->id, ordIDs);
                             }
                         }
                     }
@@ -181,22 +179,37 @@ std::vector<std::pair<float, float>> computeWorkloadDistributionCO(const DAGTask
     return WD_UCO_y;
 }
 
-float computeCarryOutUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCO_y){
+std::shared_ptr<const workloadArtifacts> getWorkloadArtifacts(const DAGTask& task, const int task_idx){
 
-    //equation 9 in the paper
-    float CO = 0, CO_tmp = 0;
+    // the cache is shared by all the copies of the task, so every Fonseca variant
+    // and every analysis of the same taskset reuses the same distributions
+    workloadArtifactCache& cache = task.getArtifactCache();
+    std::lock_guard<std::mutex> lock(cache.mtx);
+    if(cache.artifacts)
+        return cache.artifacts;
 
-    for(int i=0; i< WD_UCO_y.size();++i){
-        CO_tmp = interval; 
+    auto a = std::make_shared<workloadArtifacts>();
+    a->WD_UCO = WorkloadDistribution(computeWorkloadDistributionCO(task, task_idx), false);
+    a->WD_UCI = WorkloadDistribution(computeWorkloadDistributionCI(task), true);
 
-        for(int j=0; j < i;++j)
-            CO_tmp -= WD_UCO_y[j].first;
+    // computeWDUCO stops early when the budget is exhausted, an incomplete distribution is not cached
+    // (the budget is only queried here, budgetExhausted() would count an iteration)
+    if(!(currentBudget() && currentBudget()->isExhausted()))
+        cache.artifacts = a;
+    return a;
+}
 
-        CO += WD_UCO_y[i].second * std::max( float(0), std::min (WD_UCO_y[i].first, CO_tmp));
-    }
+float computeCarryOutUpperBound(const DAGTask& task, const int interval, const WorkloadDistribution& WD_UCO_y){
 
-    return CO;
+    //equation 9 in the paper
+    //the i-th interval contributes the part of it that falls within interval from the start of WD_UCO
+
+    float CO_tmp = interval;
+    return WD_UCO_y.workload(CO_tmp);
+}
 
+float computeCarryOutUpperBound(const DAGTask& task, const int interval, const std::vector<std::pair<float, float>>& WD_UCO_y){
+    return computeCarryOutUpperBound(task, interval, WorkloadDistribution(WD_UCO_y, false));
 }
 
 float computeImprovedCarryOutUpperBound(const DAGTask& task, const float interval, const std::vector<std::pair<float, float>>& WD_UCO_y, const int m){
@@ -209,7 +222,7 @@ float computeImprovedCarryOutUpperBound(const DAGTask& task, const float interva
     return CO;
 }
 
-float computeCarryWorkload(const DAGTask& task, const float interval, const std::vector<std::pair<float, float>>& WD_UCO_y, const std::vector<std::pair<float, float>>& WD_UCI_y){
+float computeCarryWorkload(const DAGTask& task, const float interval, const WorkloadDistribution& WD_UCO_y, const WorkloadDistribution& WD_UCI_y){
     // Algorithm 2
 
     float WyC = computeCarryOutUpperBound(task, interval, WD_UCO_y );
@@ -217,7 +230,7 @@ float computeCarryWorkload(const DAGTask& task, const float interval, const std:
     float CI = 0, CO = 0;
 
     for(int i=WD_UCI_y.size() -1; i>=0; --i){
-        x1 += WD_UCI_y[i].first;
+        x1 += WD_UCI_y.width(i);
         x2 = interval - x1;
         CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
         CO = computeCarryOutUpperBound(task, x2, WD_UCO_y);
@@ -230,7 +243,7 @@ float computeCarryWorkload(const DAGTask& task, const float interval, const std:
     x2= 0;
 
     for(int i=0; i<WD_UCO_y.size(); ++i){
-        x2 += WD_UCO_y[i].first;
+        x2 += WD_UCO_y.width(i);
         x1 = interval - x2;
 
         CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
@@ -248,7 +261,7 @@ float computeDeltaC(const DAGTask& task, const float interval){
     return interval - std::max( float(0), std::floor( (interval - L) / T )) * T;
 }
 
-float interTaskWorkload(const DAGTask& task, const float interval,  const std::vector<std::pair<float, float>>& WD_UCO_y, const std::vector<std::pair<float, float>>& WD_UCI_y){
+float interTaskWorkload(const DAGTask& task, const float interval,  const WorkloadDistribution& WD_UCO_y, const WorkloadDistribution& WD_UCI_y){
     // equation 10
 
     float delta_c = computeDeltaC(task, interval);
@@ -262,18 +275,15 @@ float interTaskWorkload(const DAGTask& task, const float interval,  const std::v
 bool GP_FP_FTP_Fonseca2017_C(Taskset taskset, const int m){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
 
-    std::vector<std::vector<std::pair<float, float>>> WD_UCO (taskset.tasks.size());
-    std::vector<std::vector<std::pair<float, float>>> WD_UCI (taskset.tasks.size());
+    std::vector<std::shared_ptr<const workloadArtifacts>> WD (taskset.tasks.size());
     for(int i=0; i<taskset.tasks.size(); ++i){
         R_old[i] = taskset.tasks[i].getLength();
         taskset.tasks[i].R = taskset.tasks[i].getLength();
-        taskset.tasks[i].computeEFTs();
 
-        WD_UCO[i] = computeWorkloadDistributionCO(taskset.tasks[i], i);
-        WD_UCI[i] = computeWorkloadDistributionCI(taskset.tasks[i]);
+        WD[i] = getWorkloadArtifacts(taskset.tasks[i], i);
     }
 
     for(int i=0; i<taskset.tasks.size(); ++i){
@@ -282,19 +292,20 @@ bool GP_FP_FTP_Fonseca2017_C(Taskset taskset, const int m){
             return false;
 
         bool init = true;
-        while(!areEqual<float>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
-            
+        while(!areEqual<Time_t>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+            if(budgetExhausted())
+                return false;
             if(!init)
                 R_old[i] = R[i];
 
             //higher prio tasks interference
             float hp_int = 0;
             for(int j=0; j<i; ++j)
-                hp_int += interTaskWorkload(taskset.tasks[j], R_old[i],  WD_UCO[j], WD_UCI[j]); 
+                hp_int += interTaskWorkload(taskset.tasks[j], R_old[i],  WD[j]->WD_UCO, WD[j]->WD_UCI); 
             hp_int *= (1. / m);
 
             // length + self interference
-            R[i] = taskset.tasks[i].getLength() + 1. / m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength()) + hp_int;
+            R[i] = toTime(taskset.tasks[i].getLength() + 1. / m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength()) + hp_int);
             init = false;
 
             // std::cout<<"i: "<<i<<" old: "<<R_old[i]<<" new: "<<R[i]<<" int: "<<hp_int<<std::endl;
@@ -302,7 +313,7 @@ bool GP_FP_FTP_Fonseca2017_C(Taskset taskset, const int m){
                 break;
         }
 
-        // if( areEqual<float>(R[i], R_old[i]))
+        // if( areEqual<Time_t>(R[i], R_old[i]))
         taskset.tasks[i].R = R[i];
         if (taskset.tasks[i].R > taskset.tasks[i].getDeadline())
             return false;
@@ -1,13 +1,15 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/WorkloadArtifacts.h"
 
 //Fonseca et al. “Schedulability Analysis of DAG Tasks with Arbitrary Deadlines under Global Fixed-Priority Scheduling”.  (Real-Time Systems 2019) 
 
 namespace dagSched{
 
-float computeCarryWorkload_C(const DAGTask& task, const float interval, const std::vector<std::pair<float, float>>& WD_UCO_y, const std::vector<std::pair<float, float>>& WD_UCI_y, const int m){
+float computeCarryWorkload_C(const DAGTask& task, const float interval, const WorkloadDistribution& WD_UCO_y, const WorkloadDistribution& WD_UCI_y, const int m){
     // Algorithm 2
 
-    float B_y = std::max(task.getLength(), task.getVolume() / m);
+    float B_y = std::max((float) task.getLength(), (float) task.getVolume() / m);
 
     float x2 = std::min(interval, B_y);
     float x1 = interval - x2;
@@ -24,7 +26,7 @@ float computeCarryWorkload_C(const DAGTask& task, const float interval, const st
     x1 = (task.getPeriod() - task.R);
 
     for(int i=WD_UCI_y.size() -1; i>=0; --i){
-        x1 += WD_UCI_y[i].first;
+        x1 += WD_UCI_y.width(i);
         x2 = interval - x1;
         if(x2 >= 0){        
             CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
@@ -36,7 +38,7 @@ float computeCarryWorkload_C(const DAGTask& task, const float interval, const st
     x2= 0;
     
     for(int i=0; i<WD_UCO_y.size(); ++i){
-        x2 += WD_UCO_y[i].first;
+        x2 += WD_UCO_y.width(i);
         x1 = interval - x2;
         if (x1 >= 0){
             CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
@@ -47,10 +49,10 @@ float computeCarryWorkload_C(const DAGTask& task, const float interval, const st
     return WyC;
 }
 
-float computeCarryWorkload_A(const DAGTask& task, const float interval, const std::vector<std::pair<float, float>>& WD_UCO_y, const std::vector<std::pair<float, float>>& WD_UCI_y, const int m){
+float computeCarryWorkload_A(const DAGTask& task, const float interval, const WorkloadDistribution& WD_UCO_y, const WorkloadDistribution& WD_UCI_y, const int m){
     // Algorithm 3
 
-    float B_y = std::max(task.getLength(), task.getVolume() / m);
+    float B_y = std::max((float) task.getLength(), (float) task.getVolume() / m);
 
     float x2 = std::min(interval, B_y);
     float x1 = interval - x2;
@@ -58,7 +60,7 @@ float computeCarryWorkload_A(const DAGTask& task, const float interval, const st
     float CO = computeCarryOutUpperBound(task, x2, WD_UCO_y);
     float WyC = CI + CO;
 
-    float ceil_D_over_T = std::ceil(task.getDeadline() / task.getPeriod());
+    float ceil_D_over_T = std::ceil((float) task.getDeadline() / task.getPeriod());
 
     x1 = std::min(interval, B_y + ceil_D_over_T * task.getPeriod() - task.R);
     x2 = interval - x1;
@@ -69,7 +71,7 @@ float computeCarryWorkload_A(const DAGTask& task, const float interval, const st
     for(int j = 0; j < ceil_D_over_T; ++j){
         x1 = (task.getPeriod() * j - task.R);
         for(int i=WD_UCI_y.size() -1; i>=0; --i){
-            x1 += WD_UCI_y[i].first;
+            x1 += WD_UCI_y.width(i);
             x2 = interval - x1;
             if(x2 >= 0 && x1 >= 0){        
                 CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
@@ -81,7 +83,7 @@ float computeCarryWorkload_A(const DAGTask& task, const float interval, const st
 
     x2= 0;
     for(int i=0; i<WD_UCO_y.size(); ++i){
-        x2 += WD_UCO_y[i].first;
+        x2 += WD_UCO_y.width(i);
         x1 = interval - x2;
         if (x1 >= 0){
             CI = computeCarryInUpperBound(task, x1, WD_UCI_y);
@@ -96,12 +98,12 @@ float computeDeltaC_B(const DAGTask& task, const float interval, const int m){
     // equation 11
     float L = task.getLength();
     float T = task.getPeriod();
-    float B = std::max(L, task.getVolume() / m);
+    float B = std::max(L, (float) task.getVolume() / m);
     return interval - std::max( float(0), std::floor( (interval - B) / T )) * T;
 }
 
 
-float interTaskWorkload_C(const DAGTask& task, const float interval,  const std::vector<std::pair<float, float>>& WD_UCO_y, const std::vector<std::pair<float, float>>& WD_UCI_y, const int m, bool constrained_deadlines = true){
+float interTaskWorkload_C(const DAGTask& task, const float interval,  const WorkloadDistribution& WD_UCO_y, const WorkloadDistribution& WD_UCI_y, const int m, bool constrained_deadlines = true){
     // equation 14
 
     float delta_c = computeDeltaC_B(task, interval, m);
@@ -120,18 +122,15 @@ float interTaskWorkload_C(const DAGTask& task, const float interval,  const std:
 bool GP_FP_FTP_Fonseca2019(Taskset taskset, const int m, bool constrained_deadlines){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
 
-    std::vector<std::vector<std::pair<float, float>>> WD_UCO (taskset.tasks.size());
-    std::vector<std::vector<std::pair<float, float>>> WD_UCI (taskset.tasks.size());
+    std::vector<std::shared_ptr<const workloadArtifacts>> WD (taskset.tasks.size());
     for(int i=0; i<taskset.tasks.size(); ++i){
         R_old[i] = taskset.tasks[i].getLength();
         taskset.tasks[i].R = taskset.tasks[i].getLength();
-        taskset.tasks[i].computeEFTs();
 
-        WD_UCO[i] = computeWorkloadDistributionCO(taskset.tasks[i], i);
-        WD_UCI[i] = computeWorkloadDistributionCI(taskset.tasks[i]);
+        WD[i] = getWorkloadArtifacts(taskset.tasks[i], i);
     }
 
     for(int i=0; i<taskset.tasks.size(); ++i){
@@ -140,18 +139,20 @@ bool GP_FP_FTP_Fonseca2019(Taskset taskset, const int m, bool constrained_deadli
             return false;
 
         bool init = true;
-        while(!areEqual<float>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+        while(!areEqual<Time_t>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+            if(budgetExhausted())
+                return false;
             if(!init)
                 R_old[i] = R[i];
 
             //higher prio tasks interference
-            R[i] = 0;
+            float hp_int = 0;
             for(int j=0; j<i; ++j)
-                R[i] += interTaskWorkload_C(taskset.tasks[j], R_old[i],  WD_UCO[j], WD_UCI[j], m, constrained_deadlines); 
-            R[i] *= (1. / m);
+                hp_int += interTaskWorkload_C(taskset.tasks[j], R_old[i],  WD[j]->WD_UCO, WD[j]->WD_UCI, m, constrained_deadlines); 
+            hp_int *= (1. / m);
 
             // length + self interference
-            R[i] += taskset.tasks[i].getLength() + 1. / m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength());
+            R[i] = toTime(hp_int + (taskset.tasks[i].getLength() + 1. / m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength())));
 
             if(R[i] < R_old[i])
                 break;
@@ -159,7 +160,7 @@ bool GP_FP_FTP_Fonseca2019(Taskset taskset, const int m, bool constrained_deadli
             init = false;
         }
 
-        // if( areEqual<float>(R[i], R_old[i]))
+        // if( areEqual<Time_t>(R[i], R_old[i]))
             taskset.tasks[i].R = R[i];
         if (R[i] > taskset.tasks[i].getDeadline())
             return false;
@@ -10,20 +10,17 @@ bool GP_FP_Han2019_C_1(const DAGTask& task, const std::vector<int> m){
     DAGTask task1 = task;
     task1.cloneVertices(task.getVertices());
 
-    task1.computeTypedVolume();
-    auto typed_vol = task.getTypedVolume();
-    auto V = task1.getVertices();
+    const std::map<int, Time_t>& typed_vol = task.getTypedVolume();
+    const auto& V = task1.getVertices();
 
     // std::cout<<"L: "<<task.getLength()<<std::endl;
 
     for(int i=0; i<V.size();++i){
         if(V[i]->gamma > m.size())
             FatalError("Problem with types of core");
-        V[i]->c *= (1. - 1. / m[V[i]->gamma]);
+        task1.setSubTaskWCET(i, toTime(V[i]->c * (1. - 1. / m[V[i]->gamma])));
     }
 
-    task1.computeLength();
-
     float L_scaled = task1.getLength();
     
     // std::cout<<"L_scaled: "<<L_scaled<<std::endl;
@@ -31,7 +28,7 @@ bool GP_FP_Han2019_C_1(const DAGTask& task, const std::vector<int> m){
     float self_int = 0;
     for(int s=0; s<m.size(); ++s){
         if(m[s] != 0 && typed_vol.find(s) != typed_vol.end()){
-            self_int += typed_vol[s] / m[s];
+            self_int += (float) typed_vol.at(s) / m[s];
         }
     }
 
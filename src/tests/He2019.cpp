@@ -1,22 +1,23 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/WorkloadBoundTable.h"
 
 // Qingqiang He et al. “Intra-task priority assignmentin real-time scheduling of dag tasks on multi-cores”. (IEEE Transactions on Parallel and Distributed Systems 2019)
 
 namespace dagSched{
 
-std::set<int> computeInferenceSet( const DAGTask & task, const int i){
+std::set<int> computeInferenceSet( const DAGTask & task, const int i, const std::vector<int>& prio){
     // definition 3
-    std::vector<SubTask *> V = task.getVertices();
-    auto ancst = task.getSubTaskAncestors(i);
-    auto desc = task.getSubTaskDescendants(i);
+    const std::vector<SubTask *>& V = task.getVertices();
+    const ReachabilityMatrix& reach = task.getReachability();
 
     std::set<int> int_set;
 
     for(int j=0; j<V.size(); ++j){
         if( j != i &&  // not i
-            V[j]->prio < V[i]->prio && // greater prio
-            std::find(ancst.begin(), ancst.end(), V[j]) == ancst.end() && // not an ancestor
-            std::find(desc.begin(), desc.end(), V[j]) == desc.end() ) // not a descendant
+            prio[j] < prio[i] && // greater prio
+            !reach.reaches(j, i) && // not an ancestor
+            !reach.reaches(i, j) ) // not a descendant
             int_set.insert(j);
     }
 
@@ -60,28 +61,37 @@ float computeR(const int i, const std::set<int>& path, const std::vector<SubTask
 
 }
 
-float computeResponseTimeBound(DAGTask& task, const int m){
+// completed is false when the analysis budget ran out before the bound was computed,
+// in that case the returned value is meaningless
+float computeResponseTimeBound(DAGTask& task, const int m, bool& completed){
     //algorithm 1
 
+    completed = false;
+
     std::vector<SubTask *> V = task.getVertices();
     std::vector<float> R(V.size());
     std::vector<std::set<int>> paths(V.size());
     std::vector<int> ordIDs = task.getTopologicalOrder();
 
-    //assign priority wrt topological order
+    //assign priority wrt topological order (kept local, the task graph is not modified)
+    std::vector<int> prio(V.size());
     for(int idx = 0, i; idx < ordIDs.size() ; ++idx ){
         i = ordIDs[idx]; // vertex index
-        V[i]->prio = idx;
+        prio[i] = idx;
     }
 
     std::vector<std::set<int>> int_sets(V.size());
     for(int i = 0; i < V.size() ; ++i ){
-        int_sets[i] = computeInferenceSet(task, i);
+        if(budgetExhausted())
+            return 0;
+        int_sets[i] = computeInferenceSet(task, i, prio);
     }
 
     //compute response time
     for(int idx = 0, i; idx < ordIDs.size() ; ++idx ){
         i = ordIDs[idx]; // vertex index
+        if(budgetExhausted())
+            return 0;
         
         if(V[i]->pred.size() != 0){
             int max_id = V[i]->pred[0]->id;
@@ -101,11 +111,14 @@ float computeResponseTimeBound(DAGTask& task, const int m){
     }
 
 
+    completed = true;
     return R[ordIDs[ordIDs.size() -1]];
 }
 
 bool GP_FP_He2019_C(DAGTask task, const int m){
-    if (computeResponseTimeBound(task, m) <= task.getDeadline())
+    bool completed;
+    float R = computeResponseTimeBound(task, m, completed);
+    if (completed && R <= task.getDeadline())
         return true;
     return false;
 }
@@ -114,34 +127,45 @@ bool GP_FP_FTP_He2019_C(Taskset taskset, const int m){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
 
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
     for(int i=0; i<taskset.tasks.size(); ++i){
         taskset.tasks[i].R = taskset.tasks[i].getLength();
         R_old[i] = taskset.tasks[i].getLength();
     }
 
+    WorkloadBoundTable hp (taskset);
+
     for(int i=0; i<taskset.tasks.size(); ++i){
 
         if(R_old[i] > taskset.tasks[i].getDeadline())
             return false;
 
         bool init = true;
-        while(!areEqual<float>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+        while(!areEqual<Time_t>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+            if(budgetExhausted())
+                return false;
             if(!init){
                 R_old[i] = R[i];
                 R[i] = 0;
             }
 
-            R[i] = computeResponseTimeBound(taskset.tasks[i], m);
+            bool completed;
+            float R_i = computeResponseTimeBound(taskset.tasks[i], m, completed);
+            if(!completed)
+                return false;
+            const float* wub = hp.bounds(i, R_old[i], m);
             for(int j=0; j<i; ++j)
-                R[i] = R[i] + (1. / m) * workloadUpperBound(taskset.tasks[j], R_old[i], m);
+                R_i = R_i + (1. / m) * wub[j];
+            R[i] = toTime(R_i);
                 
             init = false;
         }
 
-        if( areEqual<float>(R[i], R_old[i]))
+        if( areEqual<Time_t>(R[i], R_old[i])){
             taskset.tasks[i].R = R[i];
+            hp.setResponse(i, R[i]);
+        }
         else if (R[i] > taskset.tasks[i].getDeadline())
             return false;
     }
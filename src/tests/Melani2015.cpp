@@ -1,4 +1,7 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/Bitset.h"
+#include "dagSched/WorkloadBoundTable.h"
 // Alessandra Melani et al. “Response-time analysis of conditional dag tasks in multiprocessor systems”. (ECRTS 2015)
 
 namespace dagSched{
@@ -6,54 +9,62 @@ namespace dagSched{
 float computeZk(DAGTask task, const int n_proc){
     // Algorithm 2
 
-    auto V = task.getVertices();
+    const std::vector<SubTask*>& V = task.getVertices();
     auto ordIDs = task.getTopologicalOrder();
 
     if(!ordIDs.size()){
         task.topologicalSort();
         ordIDs = task.getTopologicalOrder();
     }
-    std::vector<std::set<int>> S (V.size());
-    std::vector<std::set<int>> T (V.size());
+
+    // S[v]和T[v]是按位打包的顶点集合, 位于连续数组的v * words位置
+    // 集合上的求和按顶点索引升序进行, 与遍历std::set的累加顺序相同, 结果不变
+    const int words = bitsetWords(V.size());
+    std::vector<bitword_t> S (V.size() * words, 0);
+    std::vector<bitword_t> T (V.size() * words, 0);
+    std::vector<bitword_t> D (words);
     std::vector<float> f (V.size());
-    S[ordIDs[ordIDs.size()-1]].insert(ordIDs[ordIDs.size()-1]);
-    T[ordIDs[ordIDs.size()-1]].insert(ordIDs[ordIDs.size()-1]);
-    f[ordIDs[ordIDs.size()-1]] = V[ordIDs[ordIDs.size()-1]]->c;
+    std::vector<float> c (V.size());
+    std::vector<float> c_m (V.size());
+    for(int i=0; i<V.size(); ++i){
+        c[i] = V[i]->c;
+        c_m[i] = (float) V[i]->c / n_proc;
+    }
+    auto setOf = [words](std::vector<bitword_t>& sets, const int v){ return sets.data() + v * words; };
+
+    const int last = ordIDs[ordIDs.size()-1];
+    bitsetSet(setOf(S, last), last);
+    bitsetSet(setOf(T, last), last);
+    f[last] = V[last]->c;
     
     int idx;
     float C = 0;
-    std::set<int> D;
     for(int i = ordIDs.size()-2; i >= 0; --i ){
+        // 预算耗尽时提前结束, 调用者在不动点迭代中返回
+        if(budgetExhausted())
+            break;
         idx = ordIDs[i];
 
         if(V[idx]->succ.size()){
-            S[idx].insert(idx);
+            bitsetSet(setOf(S, idx), idx);
             if(V[idx]->mode != C_SOURCE_T){ //if not conditional source
                 std::vector<float> U (V[idx]->succ.size(),0);
                 for(int j=0; j<V[idx]->succ.size(); ++j){
-                    S[idx].insert(S[V[idx]->succ[j]->id].begin(), S[V[idx]->succ[j]->id].end());
+                    bitsetOr(setOf(S, idx), setOf(S, V[idx]->succ[j]->id), words);
                     U[j] = f[V[idx]->succ[j]->id];
                     for(int k=0; k<V[idx]->succ.size(); ++k){
                         if(k!=j){
-                            C = 0;
-                            D.clear();
-                            std::set_difference(S[V[idx]->succ[k]->id].begin(), 
-                                                S[V[idx]->succ[k]->id].end(),
-                                                T[V[idx]->succ[j]->id].begin(), 
-                                                T[V[idx]->succ[j]->id].end(), 
-                                                std::inserter(D, D.begin()) );
-                        
-                            for (const auto& d:D)
-                                C+= V[d]->c / n_proc;
+                            bitsetAndNot(D.data(), setOf(S, V[idx]->succ[k]->id), setOf(T, V[idx]->succ[j]->id), words);
+                            C = bitsetSum(D.data(), words, c_m.data());
 
                             U[j]+=C;
                         }
                     }
                 }
                 int max_U_idx = std::max_element(U.begin(),U.end()) - U.begin();
-                T[idx].clear();
-                T[idx].insert(idx);
-                T[idx].insert(T[V[idx]->succ[max_U_idx]->id].begin(), T[V[idx]->succ[max_U_idx]->id].end());
+                bitword_t* T_idx = setOf(T, idx);
+                std::copy_n(setOf(T, V[idx]->succ[max_U_idx]->id), words, T_idx);
+                bitsetSet(T_idx, idx);
                 f[idx] = V[idx]->c + U[max_U_idx];
             }
             else{
@@ -61,20 +72,17 @@ float computeZk(DAGTask task, const int n_proc){
                 std::vector<float> ff (V[idx]->succ.size(),0);
 
                 for(int j=0; j<V[idx]->succ.size(); ++j){
-                    for(auto k: S[V[idx]->succ[j]->id]){
-                        C[j] += V[k]->c;
-                    }
-
+                    C[j] = bitsetSum(setOf(S, V[idx]->succ[j]->id), words, c.data());
                     ff[j] = f[V[idx]->succ[j]->id];
                 }
 
                 int max_C_idx = std::max_element(C.begin(),C.end()) - C.begin();
-                S[idx].insert(S[V[idx]->succ[max_C_idx]->id].begin(), S[V[idx]->succ[max_C_idx]->id].end());
+                bitsetOr(setOf(S, idx), setOf(S, V[idx]->succ[max_C_idx]->id), words);
 
                 int max_ff_idx = std::max_element(ff.begin(),ff.end()) - ff.begin();
-                T[idx].clear();
-                T[idx].insert(idx);
-                T[idx].insert(T[V[idx]->succ[max_ff_idx]->id].begin(), T[V[idx]->succ[max_ff_idx]->id].end());
+                bitword_t* T_idx = setOf(T, idx);
+                std::copy_n(setOf(T, V[idx]->succ[max_ff_idx]->id), words, T_idx);
+                bitsetSet(T_idx, idx);
 
                 f[idx] = V[idx]->c + f[V[idx]->succ[max_ff_idx]->id];
 
@@ -84,39 +92,42 @@ float computeZk(DAGTask task, const int n_proc){
     return f[ordIDs[0]];
 }
 
-void maximizeMakespan(const std::vector<SubTask *>& V, const SubTask* v, const std::vector<float>& mksp, const std::vector<std::set<int>>& mksp_set,  const std::vector<std::set<int>>& w_set,  std::set<int>& mkspset_tmp, float& max_mksp, const int n_proc){
+// mksp_set和w_set是按位打包的顶点集合(每个顶点words个字), c为顶点的WCET
+// mkspset_tmp和wset_tmp由调用者提供, 大小为words
+void maximizeMakespan(const SubTask* v, const std::vector<float>& c, const std::vector<float>& mksp, const bitword_t* mksp_set, const bitword_t* w_set, bitword_t* mkspset_tmp, bitword_t* wset_tmp, const int words, float& max_mksp, const int n_proc){
     max_mksp = 0;
     for(int j=0; j<v->succ.size(); ++j){
+        if(budgetExhausted())
+            return;
         float sum_w = 0;
-        std::set<int> wset_tmp;
+        std::fill_n(wset_tmp, words, 0);
+        const bitword_t* mksp_j = mksp_set + v->succ[j]->id * words;
 
         for(int k=0; k<v->succ.size(); ++k){
             if(k != j){
-                std::set<int> new_vert;
-                std::set_difference(w_set[v->succ[k]->id].begin(), 
-                                    w_set[v->succ[k]->id].end(),
-                                    wset_tmp.begin(), 
-                                    wset_tmp.end(), 
-                                    std::inserter(new_vert, new_vert.begin()) );
-                set_difference_inplace<int>(new_vert, mksp_set[v->succ[j]->id]);
-                wset_tmp.insert(new_vert.begin(), new_vert.end());
-
-                for(const auto& nv:new_vert)
-                    sum_w+= V[nv]->c;
-
+                // new_vert = w_set[k] \ wset_tmp \ mksp_set[j], 按升序累加其WCET
+                const bitword_t* w_k = w_set + v->succ[k]->id * words;
+                for(int w=0; w<words; ++w){
+                    bitword_t new_vert = w_k[w] & ~wset_tmp[w] & ~mksp_j[w];
+                    wset_tmp[w] |= new_vert;
+                    while(new_vert){
+                        sum_w+= c[(w << 6) + __builtin_ctzll(new_vert)];
+                        new_vert &= new_vert - 1;
+                    }
+                }
             }
         }
 
         if(mksp[v->succ[j]->id] + sum_w / n_proc > max_mksp){
             max_mksp = mksp[v->succ[j]->id] + sum_w / n_proc;
-            mkspset_tmp.insert(mksp_set[v->succ[j]->id].begin(), mksp_set[v->succ[j]->id].end());
-            mkspset_tmp.insert(wset_tmp.begin(), wset_tmp.end());
+            bitsetOr(mkspset_tmp, mksp_j, words);
+            bitsetOr(mkspset_tmp, wset_tmp, words);
         }
     }
 }
 
 float computeMakespanUB(DAGTask task, const int n_proc){
-    std::vector<SubTask *> V = task.getVertices();
+    const std::vector<SubTask *>& V = task.getVertices();
     std::vector<int> ordIDs = task.getTopologicalOrder();
 
     if(!ordIDs.size()){
@@ -124,23 +135,32 @@ float computeMakespanUB(DAGTask task, const int n_proc){
         ordIDs = task.getTopologicalOrder();
     }
 
-    std::vector<std::set<int>> mksp_set (V.size());
-    std::vector<std::set<int>> w_set (V.size());
+    // 与computeZk相同, 顶点集合按位打包在连续数组中
+    const int words = bitsetWords(V.size());
+    std::vector<bitword_t> mksp_set (V.size() * words, 0);
+    std::vector<bitword_t> w_set (V.size() * words, 0);
+    std::vector<bitword_t> wset_tmp (words), mkspset_tmp (words), wset_scratch (words);
     std::vector<float> w (V.size());
     std::vector<float> mksp (V.size());
+    std::vector<float> c (V.size());
+    for(int i=0; i<V.size(); ++i)
+        c[i] = V[i]->c;
+    auto setOf = [words](std::vector<bitword_t>& sets, const int v){ return sets.data() + v * words; };
     
-    mksp_set[ordIDs[ordIDs.size()-1]].insert(ordIDs[ordIDs.size()-1]);
-    w_set[ordIDs[ordIDs.size()-1]].insert(ordIDs[ordIDs.size()-1]);
-    mksp[ordIDs[ordIDs.size()-1]] = V[ordIDs[ordIDs.size()-1]]->c;
-    w[ordIDs[ordIDs.size()-1]] = V[ordIDs[ordIDs.size()-1]]->c;
+    const int last = ordIDs[ordIDs.size()-1];
+    bitsetSet(setOf(mksp_set, last), last);
+    bitsetSet(setOf(w_set, last), last);
+    mksp[last] = V[last]->c;
+    w[last] = V[last]->c;
     
     int idx;
-    float C = 0;
-    std::set<int> D;
     for(int i = ordIDs.size()-2; i >= 0; --i ){
+        // 预算耗尽时提前结束, 调用者在不动点迭代中返回
+        if(budgetExhausted())
+            break;
         idx = ordIDs[i];
-        mksp_set[idx].insert(idx);
-        w_set[idx].insert(idx);
+        bitsetSet(setOf(mksp_set, idx), idx);
+        bitsetSet(setOf(w_set, idx), idx);
         mksp[idx] = V[idx]->c;
         w[idx] = V[idx]->c;
 
@@ -150,28 +170,27 @@ float computeMakespanUB(DAGTask task, const int n_proc){
 
             float max_mksp = 0;
             float w_tmp = 0;
-            std::set<int> wset_tmp, mkspset_tmp;
-            maximizeMakespan(V, V[idx], mksp, mksp_set, w_set, mkspset_tmp, max_mksp, n_proc);
+            std::fill(mkspset_tmp.begin(), mkspset_tmp.end(), 0);
+            maximizeMakespan(V[idx], c, mksp, mksp_set.data(), w_set.data(), mkspset_tmp.data(), wset_scratch.data(), words, max_mksp, n_proc);
 
             mksp[idx] = max_mksp + V[idx]->c;
-            mksp_set[idx].insert(idx);
-            mksp_set[idx].insert(mkspset_tmp.begin(), mkspset_tmp.end());
+            bitsetOr(setOf(mksp_set, idx), mkspset_tmp.data(), words);
 
+            std::fill(wset_tmp.begin(), wset_tmp.end(), 0);
             for(int j=0; j<V[idx]->succ.size(); ++j){
-                std::set<int> new_vert;
-                std::set_difference(w_set[V[idx]->succ[j]->id].begin(), 
-                                    w_set[V[idx]->succ[j]->id].end(),
-                                    wset_tmp.begin(), 
-                                    wset_tmp.end(), 
-                                    std::inserter(new_vert, new_vert.begin()) );
-                wset_tmp.insert(new_vert.begin(), new_vert.end());
-
-                for(auto nv:new_vert)
-                    w_tmp += V[nv]->c;
+                const bitword_t* w_j = setOf(w_set, V[idx]->succ[j]->id);
+                for(int k=0; k<words; ++k){
+                    bitword_t new_vert = w_j[k] & ~wset_tmp[k];
+                    wset_tmp[k] |= new_vert;
+                    while(new_vert){
+                        w_tmp += c[(k << 6) + __builtin_ctzll(new_vert)];
+                        new_vert &= new_vert - 1;
+                    }
+                }
             }
 
             w[idx] += w_tmp;
-            w_set[idx].insert(wset_tmp.begin(), wset_tmp.end());
+            bitsetOr(setOf(w_set, idx), wset_tmp.data(), words);
 
             }
             else{
@@ -184,7 +203,7 @@ float computeMakespanUB(DAGTask task, const int n_proc){
                     }
                 }
                 mksp[idx] += max_mksp;
-                mksp_set[idx].insert(mksp_set[V[idx]->succ[max_idx]->id].begin(), mksp_set[V[idx]->succ[max_idx]->id].end());
+                bitsetOr(setOf(mksp_set, idx), setOf(mksp_set, V[idx]->succ[max_idx]->id), words);
 
                 for(int j=0; j<V[idx]->succ.size(); ++j){
                     if(w[V[idx]->succ[j]->id] > max_w){
@@ -194,7 +213,7 @@ float computeMakespanUB(DAGTask task, const int n_proc){
                 }
 
                 w[idx] += max_w;
-                w_set[idx].insert(w_set[V[idx]->succ[max_idx]->id].begin(),w_set[V[idx]->succ[max_idx]->id].end());
+                bitsetOr(setOf(w_set, idx), setOf(w_set, V[idx]->succ[max_idx]->id), words);
             }
         }
     }
@@ -203,14 +222,7 @@ float computeMakespanUB(DAGTask task, const int n_proc){
 }
 
 float workloadUpperBound(const DAGTask& task, const float t, const int m){
-
-    float wcw = task.getWorstCaseWorkload();
-    float T = task.getPeriod();
-
-    float ci_b = std::floor((t + task.R - wcw / m ) / T ) * wcw;
-    float co = std::min(wcw, m * std::fmod(t + task.R - wcw / m ,T) );
-
-    return ci_b + co;
+    return workloadBound(task.getWorstCaseWorkload(), task.getPeriod(), task.R, t, m);
 }
 
 float interferringWorkload(const DAGTask& task_x, const DAGTask& task_y , const float t, const int m){
@@ -235,11 +247,11 @@ void test_Melani(Taskset taskset, const int m){
 }
 
 bool GP_FP_EDF_Melani2015_C(Taskset taskset, const int m){
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
-    std::vector<float> mksp (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> mksp (taskset.tasks.size(), 0);
     for(int i=0; i<taskset.tasks.size(); ++i){
-        mksp[i] = computeMakespanUB(taskset.tasks[i], m);
+        mksp[i] = toTime(computeMakespanUB(taskset.tasks[i], m));
         R_old[i] = mksp[i];
         taskset.tasks[i].R = mksp[i];
     }
@@ -247,32 +259,32 @@ bool GP_FP_EDF_Melani2015_C(Taskset taskset, const int m){
     bool init = true, changed = true;
 
     while(changed){
+        if(budgetExhausted())
+            return false;
         changed = false;
         for(int i=0; i<taskset.tasks.size(); ++i){
             if(R_old[i] > taskset.tasks[i].getDeadline())
                 return false;
 
-            if(!init){
+            if(!init)
                 R_old[i] = R[i];
-                R[i] = 0;
-            }
 
             if(taskset.tasks.size() > 1){
+                float interf = 0;
                 for(int j=0; j<taskset.tasks.size(); ++j){
                     if(j != i){
-                        R[i] += (1. / m) * std::min(workloadUpperBound(taskset.tasks[j], R_old[i], m), 
+                        interf += (1. / m) * std::min(workloadUpperBound(taskset.tasks[j], R_old[i], m), 
                                                     interferringWorkload(taskset.tasks[i], taskset.tasks[j], R_old[i], m));
                     }
                 }
-                R[i] = std::floor(R[i]);
-                R[i] += mksp[i];
+                R[i] = toTime(std::floor(interf)) + mksp[i];
             }
             else
                 R[i] = R_old[i];
 
             taskset.tasks[i].R = R[i];
 
-            if( !areEqual<float>(R[i], R_old[i]) ) 
+            if( !areEqual<Time_t>(R[i], R_old[i]) ) 
                 changed = true;
 
             if(R[i] > taskset.tasks[i].getDeadline())
@@ -293,33 +305,36 @@ bool GP_FP_FTP_Melani2015_C(Taskset taskset, const int m){
 
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
-    std::vector<float> mksp (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> mksp (taskset.tasks.size(), 0);
     for(int i=0; i<taskset.tasks.size(); ++i){
-        mksp[i] = computeMakespanUB(taskset.tasks[i],m);
+        mksp[i] = toTime(computeMakespanUB(taskset.tasks[i],m));
         R_old[i] = mksp[i];
         taskset.tasks[i].R = mksp[i];
     }
 
+    WorkloadBoundTable hp (taskset);
+
     for(int i=0; i<taskset.tasks.size(); ++i){
 
         if(R_old[i] > taskset.tasks[i].getDeadline())
             return false;
 
         bool init = true;
-        while(!areEqual<float>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
-            if(!init){
+        while(!areEqual<Time_t>(R[i], R_old[i]) && R[i] <= taskset.tasks[i].getDeadline()){
+            if(budgetExhausted())
+                return false;
+            if(!init)
                 R_old[i] = R[i];
-                R[i] = 0;
-            }
 
             if(i > 0){
+                float interf = 0;
+                const float* wub = hp.bounds(i, R_old[i], m);
                 for(int j=0; j<i; ++j)
-                    R[i] = R[i] + (1. / m) * workloadUpperBound(taskset.tasks[j], R_old[i], m);
+                    interf = interf + (1. / m) * wub[j];
 
-                R[i] = std::floor(R[i]);
-                R[i] += mksp[i];
+                R[i] = toTime(std::floor(interf)) + mksp[i];
             }
             else
                 R[i] = R_old[i];
@@ -327,8 +342,10 @@ bool GP_FP_FTP_Melani2015_C(Taskset taskset, const int m){
             init = false;
         }
 
-        if( areEqual<float>(R[i], R_old[i]))
+        if( areEqual<Time_t>(R[i], R_old[i])){
             taskset.tasks[i].R = R[i];
+            hp.setResponse(i, R[i]);
+        }
         else if (R[i] > taskset.tasks[i].getDeadline())
             return false;
     }
@@ -1,10 +1,14 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
 
 #include"problem.hpp"
 #include "io.hpp"
 #include "global/space.hpp"
 
-#include <oneapi/tbb/global_control.h>
+#include <oneapi/tbb/info.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include <algorithm>
 
 namespace dagSched{
 
@@ -12,27 +16,35 @@ bool test(std::istream &in,
 	std::istream &dag_in,
 	std::istream &aborts_in, const int m){
 
-        tbb::global_control c(
-            tbb::global_control::max_allowed_parallelism, 
-            8
-        );
-
     NP::Scheduling_problem<dtime_t> problem{
 		NP::parse_file<dtime_t>(in),
 		NP::parse_dag_file(dag_in),
 		NP::parse_abort_file<dtime_t>(aborts_in),
 		m};
 
+	// the state space exploration is bounded by the remaining time of the analysis budget, if any
+	AnalysisBudget* budget = currentBudget();
+
     // Set common analysis options
 	NP::Analysis_options opts;
-	opts.timeout = 0;
+	opts.timeout = budget != nullptr && budget->hasTimeLimit() ? budget->remainingTime() : 0;
 	opts.max_depth = 0;
 	opts.early_exit = true;
 	opts.num_buckets = problem.jobs.size();
 	opts.be_naive = 0;
 
 	// Actually call the analysis engine
-	auto space = NP::Global::State_space<dtime_t>::explore(problem, opts);
+	// the exploration uses at most 8 threads in its own arena, the limit does not
+	// apply to the rest of the process (e.g. the other tasksets of evaluate())
+	tbb::task_arena arena(std::min(8, tbb::info::default_concurrency()));
+	auto space = arena.execute([&]{
+		return NP::Global::State_space<dtime_t>::explore(problem, opts);
+	});
+	if(space.was_timed_out()){
+		if(budget != nullptr)
+			budget->exhaust();
+		return false;
+	}
 
 	// Extract the analysis results
 	// auto graph = std::ostringstream();
@@ -53,6 +65,15 @@ bool test(std::istream &in,
 	return space.is_schedulable(); 
 }
 
+// the np-schedulability-analysis CSV format expects integer times:
+// integer ticks are written as they are, float times are truncated as before
+std::string timeToCsv(const Time_t v){
+    if constexpr (std::is_integral<Time_t>::value)
+        return std::to_string(v);
+    else
+        return std::to_string((int) v);
+}
+
 std::string convertTasksetToCsv(Taskset& taskset){
 
     std::string task_set = "   Task ID,     Job ID,          Arrival min,          Arrival max,             Cost min,             Cost max,             Deadline,             Priority\n";
@@ -66,10 +87,10 @@ std::string convertTasksetToCsv(Taskset& taskset){
                         ", " + std::to_string(i) +  //Job ID
                         ", 0 " + //Release min
                         ", 0 " + //Release max
-                        ", " + std::to_string((int)V[i]->c) + //Cost min
-                        ", " + std::to_string((int)V[i]->c) + //Cost max
-                        ", " + std::to_string((int)taskset.tasks[x].getDeadline()) + //Deadline
-                        ", " + std::to_string((int)taskset.tasks[x].getDeadline()) + "\n";  //Priority
+                        ", " + timeToCsv(V[i]->c) + //Cost min
+                        ", " + timeToCsv(V[i]->c) + //Cost max
+                        ", " + timeToCsv(taskset.tasks[x].getDeadline()) + //Deadline
+                        ", " + timeToCsv(taskset.tasks[x].getDeadline()) + "\n";  //Priority
             
         }
     }
@@ -1,4 +1,6 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/AnalysisScratch.h"
 
 //Risat Pathan et al.  “Scheduling parallel real-time recurrent tasks on multicore platforms”. (IEEE Transactions on Parallel and Distributed Systems 2017)
 
@@ -7,9 +9,8 @@ namespace dagSched{
 std::vector<int> computeSxi(const DAGTask& tau_x, const int k ){
     //topological order to priorities nodes
     std::vector<int> topo_ord = tau_x.getTopologicalOrder();
-    auto V = tau_x.getVertices();
+    const ReachabilityMatrix& reach = tau_x.getReachability();
     int idx = 0;
-    bool is_succ = false;
 
     std::vector<int> S;
     for(int i=0; i<topo_ord.size(); ++i){
@@ -17,31 +18,29 @@ std::vector<int> computeSxi(const DAGTask& tau_x, const int k ){
         //if the node is before in topological order
         if(idx == k) break;
 
-        is_succ = false;
-        
         //and if it is not one of v_k ancestors
-        tau_x.isSuccessor(V[k], V[idx], is_succ);
-        if(!is_succ)
+        if(!reach.reaches(idx, k))
             S.push_back(idx);
     }
 
     return S;
 }
 
-float computeLatestReadyTime(const std::vector<SubTask *>& ancst_i){
-    float max_R = 0;
+template<typename SubTaskList>
+Time_t computeLatestReadyTime(const SubTaskList& ancst_i, const std::vector<Time_t>& r){
+    Time_t max_R = 0;
 
     for(int j=0; j< ancst_i.size(); ++j){
-        if(ancst_i[j]->r > max_R)
-            max_R = ancst_i[j]->r;
+        if(r[ancst_i[j]->id] > max_R)
+            max_R = r[ancst_i[j]->id];
     }
 
     return max_R;
 }
 
-float computeWorloadIntra(const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k ){
+float computeWorloadIntra(const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k, const std::vector<Time_t>& r_x ){
     std::vector<int> S = computeSxi(tau_x, k);
-    auto V = tau_x.getVertices();
+    const auto& V = tau_x.getVertices();
     
     float W_intra = 0;
     float R_part = 0;
@@ -49,22 +48,21 @@ float computeWorloadIntra(const DAGTask& tau_x, const int k, const std::vector<S
     for(int i=0; i< S.size(); ++i){
         idx = S[i];
 
-        R_part = std::max( float(0) , V[idx]->r - computeLatestReadyTime(ancst_k) );
-        W_intra += std::min(V[idx]->c, R_part);
+        R_part = std::max( float(0) , float(r_x[idx] - computeLatestReadyTime(ancst_k, r_x)) );
+        W_intra += std::min((float) V[idx]->c, R_part);
     }
 
     return W_intra;
 }
 
-float computeX(const DAGTask& tau_y, const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k, const float interval, const int m ){
-    auto V = tau_x.getVertices();
-    float ci_b = computeLatestReadyTime(ancst_k) + interval - tau_y.getWCW() / m;
+float computeX(const DAGTask& tau_y, const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k, const std::vector<Time_t>& r_x, const float interval, const int m ){
+    float ci_b = computeLatestReadyTime(ancst_k, r_x) + interval - (float) tau_y.getWCW() / m;
     return std::max( float(0), ci_b );
 }
 
-float computeTcin(const DAGTask& tau_y, const DAGTask& tau_x, const int k,const std::vector<SubTask*>& ancst_k, const float interval, const int m ){
+float computeTcin(const DAGTask& tau_y, const DAGTask& tau_x, const int k,const std::vector<SubTask*>& ancst_k, const std::vector<Time_t>& r_x, const float interval, const int m ){
 
-    float X_y = computeX(tau_y, tau_x, k, ancst_k, interval, m);
+    float X_y = computeX(tau_y, tau_x, k, ancst_k, r_x, interval, m);
     float W_y = tau_x.getWCW();
     float T_y = tau_x.getPeriod();
 
@@ -73,18 +71,17 @@ float computeTcin(const DAGTask& tau_y, const DAGTask& tau_x, const int k,const
 
 }
 
-float computeCR(const DAGTask& tau_y, const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k, const float interval, const int m ){
-    auto V_x = tau_x.getVertices();
-    auto V_y = tau_y.getVertices();
+float computeCR(const DAGTask& tau_y, const DAGTask& tau_x, const int k, const std::vector<SubTask*>& ancst_k, const std::vector<Time_t>& r_x, const std::vector<Time_t>& r_y, const float interval, const int m ){
+    const auto& V_y = tau_y.getVertices();
     float A = 0;
 
     for(int i=0; i<V_y.size(); ++i)
-        A += std::min(V_y[i]->c, std::max(float(0), V_y[i]->r - computeLatestReadyTime(ancst_k)));
+        A += std::min((float) V_y[i]->c, std::max(float(0), float(r_y[i] - computeLatestReadyTime(ancst_k, r_x))));
     
-    return std::min (m * computeTcin(tau_y, tau_x, k, ancst_k, interval, m) , A);
+    return std::min (m * computeTcin(tau_y, tau_x, k, ancst_k, r_x, interval, m) , A);
 }
 
-float computeWorloadInter(const Taskset& taskset, const int x, const int i, const std::vector<SubTask*>& ancst_i, const float interval, const int m){
+float computeWorloadInter(const Taskset& taskset, const AnalysisScratch& scratch, const int x, const int i, const std::vector<SubTask*>& ancst_i, const float interval, const int m){
 
     //for all hp of tau_x
     float W_inter = 0;
@@ -93,9 +90,9 @@ float computeWorloadInter(const Taskset& taskset, const int x, const int i, cons
 
         T_y = taskset.tasks[y].getPeriod();
         W_y = taskset.tasks[y].getWCW();
-        t_cin_y = computeTcin(taskset.tasks[y], taskset.tasks[x], i, ancst_i, interval, m);
-        X_y = computeX(taskset.tasks[y], taskset.tasks[x], i, ancst_i, interval, m);
-        CR_y = computeCR(taskset.tasks[y], taskset.tasks[x], i, ancst_i, t_cin_y, m);
+        t_cin_y = computeTcin(taskset.tasks[y], taskset.tasks[x], i, ancst_i, scratch[x].r, interval, m);
+        X_y = computeX(taskset.tasks[y], taskset.tasks[x], i, ancst_i, scratch[x].r, interval, m);
+        CR_y = computeCR(taskset.tasks[y], taskset.tasks[x], i, ancst_i, scratch[x].r, scratch[y].r, t_cin_y, m);
 
         W_inter += CR_y + std::floor( X_y / T_y ) * W_y + W_y;
 
@@ -109,13 +106,17 @@ bool GP_FP_DM_Pathan2017_C(Taskset taskset, const int m){
 
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
+    // per-node response times live in the scratch buffer, the task graphs are not modified
+    AnalysisScratch scratch(taskset);
+
     for(int x=0; x<taskset.tasks.size(); ++x){
 
         std::vector<int> topo_ord = taskset.tasks[x].getTopologicalOrder();
-        auto V = taskset.tasks[x].getVertices();
+        const auto& V = taskset.tasks[x].getVertices();
+        std::vector<Time_t>& r = scratch[x].r;
 
-        std::vector<float> R_old (V.size(), 0);
-        std::vector<float> R (V.size(), 0);
+        std::vector<Time_t> R_old (V.size(), 0);
+        std::vector<Time_t> R (V.size(), 0);
 
         // compute the response of a subtask in topological order
         for(int idx=0, i; idx<topo_ord.size(); ++idx){
@@ -124,23 +125,23 @@ bool GP_FP_DM_Pathan2017_C(Taskset taskset, const int m){
             std::vector<SubTask*> ancst_i = taskset.tasks[x].getSubTaskAncestors(i);
 
             R_old[i] = V[i]->c;
-            V[i]->r = V[i]->c;
+            r[i] = V[i]->c;
             
             if(R_old[i] > taskset.tasks[x].getDeadline())
                 return false;
 
             bool init = true;
             float W_intra = 0, W_inter = 0;
-            while(!areEqual<float>(R[i], R_old[i]) && R[i] <= taskset.tasks[x].getDeadline()){
-                if(!init){
+            while(!areEqual<Time_t>(R[i], R_old[i]) && R[i] <= taskset.tasks[x].getDeadline()){
+                if(budgetExhausted())
+                    return false;
+                if(!init)
                     R_old[i] = R[i];
-                    R[i] = 0;
-                }
 
-                W_inter = computeWorloadInter(taskset, x, i, ancst_i, R_old[i], m);
-                W_intra = computeWorloadIntra(taskset.tasks[x], i, ancst_i);
+                W_inter = computeWorloadInter(taskset, scratch, x, i, ancst_i, R_old[i], m);
+                W_intra = computeWorloadIntra(taskset.tasks[x], i, ancst_i, r);
 
-                R[i] += computeLatestReadyTime(V[i]->pred) + (1. / m) * (W_intra + W_inter) + V[i]->c;
+                R[i] = toTime(computeLatestReadyTime(V[i]->pred, r) + (1. / m) * (W_intra + W_inter) + V[i]->c);
 
                 init = false;
                 if(R[i] < R_old[i])
@@ -149,14 +150,14 @@ bool GP_FP_DM_Pathan2017_C(Taskset taskset, const int m){
 
             if(R[i] > taskset.tasks[x].getDeadline())
                 return false;
-            V[i]->r = R[i];
+            r[i] = R[i];
         }
 
         // the response time of the task is the max response time of one of its nodes
         taskset.tasks[x].R = 0;
         for(int i=0; i<V.size(); ++i){
-            if(V[i]->r > taskset.tasks[x].R)
-                taskset.tasks[x].R = V[i]->r;
+            if(r[i] > taskset.tasks[x].R)
+                taskset.tasks[x].R = r[i];
         }
 
         if (taskset.tasks[x].R > taskset.tasks[x].getDeadline())
@@ -10,26 +10,24 @@ bool GP_FP_EDF_Qamhieh2013_C(Taskset taskset, const int m){
 
     float cumulativeDBF = 0;
     float cumulativeCarryIn = 0;
-    
-    for(auto& task:taskset.tasks){
-        if(!(task.getDeadline() <= task.getPeriod()))
-            FatalError("This test requires constrained deadline tasks");
 
-        task.computeLocalOffsets();
-        task.computeLocalDeadlines();
+    for(int x=0; x<taskset.tasks.size(); ++x){
+        if(!(taskset.tasks[x].getDeadline() <= taskset.tasks[x].getPeriod()))
+            FatalError("This test requires constrained deadline tasks");
     }
 
     for(int x=0; x<taskset.tasks.size(); ++x){
         for(int y=0; y<taskset.tasks.size(); ++y){
+            const std::vector<Time_t>& localD = taskset.tasks[y].getLocalDeadlines();
             for(const auto& v: taskset.tasks[y].getVertices())
                 cumulativeDBF += std::max(0, demandBoundFunction(taskset.tasks[x].getDeadline(), 
-                                                                 v->localD, 
+                                                                 localD[v->id], 
                                                                  taskset.tasks[y].getPeriod(), 
                                                                  v->c ));
 
             if(x != y){
                 for(const auto& v: taskset.tasks[y].getVertices())
-                    cumulativeCarryIn += std::fmin(v->c, std::fmax(0, v->localD));
+                    cumulativeCarryIn += std::fmin(v->c, std::fmax(0, localD[v->id]));
             }
         }
 
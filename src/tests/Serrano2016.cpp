@@ -1,4 +1,6 @@
 #include "dagSched/tests.h"
+#include "dagSched/AnalysisBudget.h"
+#include "dagSched/WorkloadBoundTable.h"
 
 //Maria A Serrano et al. “Response-time analysis of DAG tasks under fixed priority scheduling with limited preemptions” (DATE 2016)
 
@@ -53,14 +55,16 @@ float blockingWorkload(const Taskset& taskset, const int x , const float interva
 bool GP_LP_FTP_Serrano16_C(Taskset taskset, const int m){
     std::sort(taskset.tasks.begin(), taskset.tasks.end(), deadlineMonotonicSorting);
 
-    std::vector<float> R_old (taskset.tasks.size(), 0);
-    std::vector<float> R (taskset.tasks.size(), 0);
+    std::vector<Time_t> R_old (taskset.tasks.size(), 0);
+    std::vector<Time_t> R (taskset.tasks.size(), 0);
 
     for(int i=0; i<taskset.tasks.size(); ++i){
-        R_old[i] = taskset.tasks[i].getLength() + 1./m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength());
+        R_old[i] = toTime(taskset.tasks[i].getLength() + 1./m * (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength()));
         taskset.tasks[i].R = R_old[i];
     }
 
+    WorkloadBoundTable hp (taskset);
+
     float interf = 0;
     float blocking = 0;
     float SI = 0;
@@ -69,6 +73,8 @@ bool GP_LP_FTP_Serrano16_C(Taskset taskset, const int m){
     bool init = true;
 
     while(at_least_one_update){
+        if(budgetExhausted())
+            return false;
         at_least_one_update = false;
 
         for(int i=0; i<taskset.tasks.size(); ++i){
@@ -76,15 +82,14 @@ bool GP_LP_FTP_Serrano16_C(Taskset taskset, const int m){
             if(R_old[i] > taskset.tasks[i].getDeadline())
                 return false;
 
-            if(!init){
+            if(!init)
                 R_old[i] = R[i];
-                R[i] = 0;
-            }
 
             //for all hp
             interf = 0;
+            const float* wub = hp.bounds(i, R_old[i], m);
             for(int j=0; j<i; ++j)
-                interf += workloadUpperBound(taskset.tasks[j], R_old[i], m);
+                interf += wub[j];
 
             //for all lp
             blocking = blockingWorkload(taskset, i, R_old[i], m);
@@ -93,11 +98,12 @@ bool GP_LP_FTP_Serrano16_C(Taskset taskset, const int m){
             SI = (taskset.tasks[i].getVolume() - taskset.tasks[i].getLength());
 
             //final response time
-            R[i] = taskset.tasks[i].getLength() + 1. / m * SI + std::floor(1. / m * (blocking + interf));
+            R[i] = toTime(taskset.tasks[i].getLength() + 1. / m * SI + std::floor(1. / m * (blocking + interf)));
 
             taskset.tasks[i].R = R[i];
+            hp.setResponse(i, R[i]);
 
-            if( !areEqual<float>(R[i], R_old[i]))
+            if( !areEqual<Time_t>(R[i], R_old[i]))
                 at_least_one_update = true;
             
             if (R[i] > taskset.tasks[i].getDeadline())
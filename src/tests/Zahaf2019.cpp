@@ -2,6 +2,8 @@
 
 #ifdef ZAHAF2019
 
+#include <mutex>
+
 #include "task/task.hpp"
 #include "gramm/hdag_driver.hpp"
 #include "code_gen/taskset_code.hpp"
@@ -12,6 +14,11 @@ namespace dagSched{
 
 bool P_LP_EDF_Zahaf2019_C(const Taskset& taskset, const int m){
 
+    // the taskset goes through a fixed file and the external parser, so concurrent
+    // evaluations of different tasksets have to take turns
+    static std::mutex zahaf_mutex;
+    std::lock_guard<std::mutex> lock(zahaf_mutex);
+
     std::ofstream output_file;
     std::string filename = "cur_zahaf2019.txt";
     output_file.open (filename);
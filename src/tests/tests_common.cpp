@@ -104,8 +104,8 @@ bool WorstFitProcessorsAssignment(Taskset& taskset, const int m){
             node_infos n;
             n.task_id = x;
             n.v_id = i;
-            n.density = taskset.tasks[x].getLength() / taskset.tasks[x].getDeadline();
-            n.utilization = V[i]->c / taskset.tasks[x].getPeriod();
+            n.density = taskset.tasks[x].getDensity();
+            n.utilization = (float) V[i]->c / taskset.tasks[x].getPeriod();
 
             taskset_nodes.push_back(n);
         }
@@ -127,12 +127,15 @@ bool WorstFitProcessorsAssignment(Taskset& taskset, const int m){
         if(min_idx == -1)
             return false;
 
-        SubTask *v = taskset.tasks[taskset_nodes[i].task_id].getVertices()[taskset_nodes[i].v_id];
-        v->core = min_idx;
+        taskset.tasks[taskset_nodes[i].task_id].setSubTaskCore(taskset_nodes[i].v_id, min_idx);
         proc_util[min_idx] += taskset_nodes[i].utilization;    
 
     }
 
+    // partitioned volumes are refreshed here, so that the copies used by the tests find them computed
+    for(auto& task: taskset.tasks)
+        task.computepVolume();
+
     return true;
 }
 
@@ -146,7 +149,7 @@ bool BestFitProcessorsAssignment(Taskset& taskset, const int m){
     for(int x=0; x<taskset.tasks.size();++x){
         std::vector<SubTask*> V = taskset.tasks[x].getVertices();
         for(int i=0; i<V.size(); ++i){
-            cur_util = V[i]->c / taskset.tasks[x].getPeriod();
+            cur_util = (float) V[i]->c / taskset.tasks[x].getPeriod();
 
             min_proc_util = 1;
             min_idx = -1;
@@ -162,10 +165,11 @@ bool BestFitProcessorsAssignment(Taskset& taskset, const int m){
             if(min_idx == -1)
                 return false;
 
-            V[i]->core = min_idx;
+            taskset.tasks[x].setSubTaskCore(i, min_idx);
             proc_util[min_idx] += cur_util;            
         }
 
+        taskset.tasks[x].computepVolume();
         // std::cout<<taskset.tasks[x];
     }
 
@@ -1,15 +1,5 @@
 #include "dagSched/utils.h"
 
-// 生成[min,max]范围内的随机整数
-int intRandMaxMin(const int v_min, const int v_max){
-    return rand() %  std::max(v_max - v_min, 1) + v_min;
-}
-
-// 生成[min,max]范围内的随机浮点数
-float floatRandMaxMin(const float v_min, const float v_max){
-    return std::fmod (rand(), std::max(v_max - v_min, float(1))) + v_min;
-}
-
 // 从完整路径中移除路径和扩展名
 void removePathAndExtension(const std::string &full_string, std::string &name){
     name = full_string;
@@ -107,9 +97,9 @@ dot_info parseDOTLine(const std::string& line){
         auto pairs = separateOnComma(brackets_content);
         for(auto p:pairs){
             if(p.first == "D")
-                line_info.deadline = std::stof(p.second);
+                line_info.deadline = toTimeDown(std::stof(p.second));
             if(p.first == "T")
-                line_info.period = std::stof(p.second);
+                line_info.period = toTimeDown(std::stof(p.second));
         }
     }
     else if( start_node != std::string::npos && end_node != std::string::npos){
@@ -124,7 +114,7 @@ dot_info parseDOTLine(const std::string& line){
         auto pairs = separateOnComma(brackets_content);
         for(auto p:pairs){
             if(p.first == "label")
-                line_info.wcet = std::stof(p.second);
+                line_info.wcet = toTime(std::stof(p.second));
             if(p.first == "p")
                 line_info.p = std::stof(p.second);
             if(p.first == "s")